@@ -37,6 +37,8 @@
       'atom/common/api/lib/id-weak-map.coffee',
       'atom/common/api/lib/screen.coffee',
       'atom/common/api/lib/shell.coffee',
+      'atom/common/lib/archive.coffee',
+      'atom/common/lib/code-cache.coffee',
       'atom/common/lib/init.coffee',
       'atom/renderer/lib/init.coffee',
       'atom/renderer/lib/inspector.coffee',
@@ -121,8 +123,16 @@
       'atom/browser/net/atom_url_request_context_getter.h',
       'atom/browser/net/atom_url_request_job_factory.cc',
       'atom/browser/net/atom_url_request_job_factory.h',
+      'atom/browser/net/protocol_response_cache.cc',
+      'atom/browser/net/protocol_response_cache.h',
+      'atom/browser/net/url_request_buffer_job.cc',
+      'atom/browser/net/url_request_buffer_job.h',
+      'atom/browser/net/url_request_stream_job.cc',
+      'atom/browser/net/url_request_stream_job.h',
       'atom/browser/net/url_request_string_job.cc',
       'atom/browser/net/url_request_string_job.h',
+      'atom/browser/renderer_process_pool.cc',
+      'atom/browser/renderer_process_pool.h',
       'atom/browser/ui/accelerator_util.cc',
       'atom/browser/ui/accelerator_util.h',
       'atom/browser/ui/accelerator_util_mac.mm',
@@ -167,18 +177,26 @@
       'atom/browser/window_list_observer.h',
       'atom/common/api/api_messages.cc',
       'atom/common/api/api_messages.h',
+      'atom/common/api/atom_api_archive.cc',
+      'atom/common/api/atom_api_archive.h',
       'atom/common/api/atom_api_clipboard.cc',
+      'atom/common/api/atom_api_code_cache.cc',
       'atom/common/api/atom_api_crash_reporter.cc',
       'atom/common/api/atom_api_id_weak_map.cc',
       'atom/common/api/atom_api_id_weak_map.h',
+      'atom/common/api/atom_api_objects_store.cc',
+      'atom/common/api/atom_api_objects_store.h',
       'atom/common/api/atom_api_screen.cc',
       'atom/common/api/atom_api_screen.h',
       'atom/common/api/atom_api_shell.cc',
+      'atom/common/api/atom_api_uv_loop.cc',
       'atom/common/api/atom_api_v8_util.cc',
       'atom/common/api/atom_bindings.cc',
       'atom/common/api/atom_bindings.h',
       'atom/common/api/object_life_monitor.cc',
       'atom/common/api/object_life_monitor.h',
+      'atom/common/archive.cc',
+      'atom/common/archive.h',
       'atom/common/crash_reporter/crash_reporter.cc',
       'atom/common/crash_reporter/crash_reporter.h',
       'atom/common/crash_reporter/crash_reporter_linux.cc',
@@ -205,6 +223,8 @@
       'atom/common/native_mate_converters/string16_converter.h',
       'atom/common/native_mate_converters/v8_value_converter.cc',
       'atom/common/native_mate_converters/v8_value_converter.h',
+      'atom/common/native_mate_converters/v8_value_serializer.cc',
+      'atom/common/native_mate_converters/v8_value_serializer.h',
       'atom/common/native_mate_converters/value_converter.cc',
       'atom/common/native_mate_converters/value_converter.h',
       'atom/common/node_bindings.cc',
@@ -222,6 +242,7 @@
       'atom/common/platform_util_linux.cc',
       'atom/common/platform_util_mac.mm',
       'atom/common/platform_util_win.cc',
+      'atom/common/slot_map.h',
       'atom/renderer/api/atom_api_renderer_ipc.cc',
       'atom/renderer/api/atom_renderer_bindings.cc',
       'atom/renderer/api/atom_renderer_bindings.h',
@@ -4,11 +4,13 @@
 
 #include "atom/browser/api/atom_api_app.h"
 
+#include <algorithm>
 #include <string>
 
 #include "base/values.h"
 #include "base/command_line.h"
 #include "atom/browser/browser.h"
+#include "atom/browser/renderer_process_pool.h"
 #include "native_mate/dictionary.h"
 #include "native_mate/object_template_builder.h"
 
@@ -98,6 +100,21 @@ void AppendSwitch(const std::string& switch_string, mate::Arguments* args) {
     CommandLine::ForCurrentProcess()->AppendSwitch(switch_string);
 }
 
+void SetRendererProcessPoolSize(int size) {
+  atom::RendererProcessPool::GetInstance()->SetSize(std::max(size, 0));
+}
+
+v8::Handle<v8::Value> GetRendererProcessPoolStats(v8::Isolate* isolate) {
+  atom::RendererProcessPool* pool = atom::RendererProcessPool::GetInstance();
+  mate::Dictionary dict(isolate);
+  dict.Set("size", static_cast<int>(pool->size()));
+  dict.Set("spares", static_cast<int>(pool->spare_count()));
+  dict.Set("hits", pool->hits());
+  dict.Set("misses", pool->misses());
+  dict.Set("spareProcessIds", pool->GetSpareProcessIds());
+  return mate::ConvertToV8(isolate, dict);
+}
+
 #if defined(OS_MACOSX)
 int DockBounce(const std::string& type) {
   int request_id = -1;
@@ -121,6 +138,8 @@ void Initialize(v8::Handle<v8::Object> exports, v8::Handle<v8::Value> unused,
   dict.SetMethod("appendArgument",
                  base::Bind(&CommandLine::AppendArg,
                             base::Unretained(command_line)));
+  dict.SetMethod("setRendererProcessPoolSize", &SetRendererProcessPoolSize);
+  dict.SetMethod("getRendererProcessPoolStats", &GetRendererProcessPoolStats);
 #if defined(OS_MACOSX)
   dict.SetMethod("dockBounce", &DockBounce);
   dict.SetMethod("dockCancelBounce",
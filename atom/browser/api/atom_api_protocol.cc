@@ -4,16 +4,36 @@
 
 #include "atom/browser/api/atom_api_protocol.h"
 
+#include <algorithm>
+#include <deque>
+
+#include "base/file_util.h"
+#include "base/float_util.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/stl_util.h"
+#include "base/strings/string_util.h"
+#include "base/threading/sequenced_worker_pool.h"
 #include "atom/browser/atom_browser_context.h"
 #include "atom/browser/net/adapter_request_job.h"
 #include "atom/browser/net/atom_url_request_context_getter.h"
 #include "atom/browser/net/atom_url_request_job_factory.h"
+#include "atom/browser/net/protocol_response_cache.h"
+#include "atom/browser/net/url_request_buffer_job.h"
 #include "atom/common/native_mate_converters/file_path_converter.h"
 #include "content/public/browser/browser_thread.h"
 #include "native_mate/callback.h"
 #include "native_mate/dictionary.h"
+#include "native_mate/object_template_builder.h"
+#include "native_mate/scoped_persistent.h"
+#include "net/base/escape.h"
+#include "net/base/mime_util.h"
+#include "net/base/net_errors.h"
+#include "net/base/upload_bytes_element_reader.h"
+#include "net/base/upload_data_stream.h"
+#include "net/http/http_request_headers.h"
 #include "net/url_request/url_request_context.h"
+#include "net/url_request/url_request_error_job.h"
+#include "net/url_request/url_request_file_job.h"
 
 #include "atom/common/node_includes.h"
 
@@ -25,11 +45,35 @@ template<>
 struct Converter<const net::URLRequest*> {
   static v8::Handle<v8::Value> ToV8(v8::Isolate* isolate,
                                     const net::URLRequest* val) {
-    return mate::ObjectTemplateBuilder(isolate)
+    v8::Handle<v8::Object> headers = v8::Object::New(isolate);
+    net::HttpRequestHeaders::Iterator it(val->extra_request_headers());
+    while (it.GetNext())
+      headers->Set(mate::StringToV8(isolate, it.name()),
+                   mate::StringToV8(isolate, it.value()));
+
+    // Only the data in memory is exposed, files being uploaded are skipped.
+    v8::Handle<v8::Array> upload_data = v8::Array::New(isolate);
+    const net::UploadDataStream* upload = val->get_upload();
+    if (upload) {
+      const ScopedVector<net::UploadElementReader>& readers =
+          upload->element_readers();
+      for (size_t i = 0; i < readers.size(); ++i) {
+        const net::UploadBytesElementReader* reader =
+            readers[i]->AsBytesReader();
+        if (reader)
+          upload_data->Set(upload_data->Length(), node::Buffer::New(
+              reader->bytes(), reader->length()));
+      }
+    }
+
+    v8::Handle<v8::Object> result = mate::ObjectTemplateBuilder(isolate)
         .SetValue("method", val->method())
         .SetValue("url", val->url().spec())
         .SetValue("referrer", val->referrer())
         .Build()->NewInstance();
+    result->Set(mate::StringToV8(isolate, "headers"), headers);
+    result->Set(mate::StringToV8(isolate, "uploadData"), upload_data);
+    return result;
   }
 };
 
@@ -44,35 +88,267 @@ namespace {
 
 typedef net::URLRequestJobFactory::ProtocolHandler ProtocolHandler;
 
-class CustomProtocolRequestJob : public AdapterRequestJob {
+// Returns the path used to look up the static routes of |url|, which is the
+// unescaped content after "scheme:" without the leading slashes, query and
+// ref, e.g. "app://index.html?a=b" gives "index.html".
+std::string GetStaticRoutePath(const GURL& url) {
+  std::string content = url.GetContent();
+  size_t end = content.find_first_of("?#");
+  if (end != std::string::npos)
+    content.resize(end);
+  size_t begin = content.find_first_not_of('/');
+  if (begin == std::string::npos)
+    return std::string();
+  return net::UnescapeURLComponent(
+      content.substr(begin),
+      net::UnescapeRule::SPACES | net::UnescapeRule::URL_SPECIAL_CHARS);
+}
+
+// Strips the leading slashes of |path| set by users, so "/index.html" and
+// "index.html" refer to the same route.
+std::string NormalizeStaticRoutePath(const std::string& path) {
+  size_t begin = path.find_first_not_of('/');
+  return begin == std::string::npos ? std::string() : path.substr(begin);
+}
+
+// Like NormalizeStaticRoutePath but also strips the trailing slashes, so
+// "/assets/" and "assets" refer to the same directory mapping.
+std::string NormalizeStaticRoutePrefix(const std::string& prefix) {
+  std::string normalized = NormalizeStaticRoutePath(prefix);
+  normalized.resize(normalized.find_last_not_of('/') + 1);
+  return normalized;
+}
+
+// Reads the response headers set by JS, the values are converted to strings.
+void GetHeaders(v8::Handle<v8::Object> object,
+                URLRequestBufferJob::HeadersMap* headers) {
+  v8::Handle<v8::Array> names = object->GetOwnPropertyNames();
+  for (uint32 i = 0; i < names->Length(); ++i) {
+    v8::Handle<v8::Value> name = names->Get(i);
+    (*headers)[mate::V8ToString(name)] = mate::V8ToString(
+        object->Get(name)->ToString());
+  }
+}
+
+// Files larger than this are not read into the response cache.
+const size_t kMaxCachedFileSize = 16 * 1024 * 1024;
+
+// Whether the response headers set by JS forbid caching the response.
+bool IsNoStore(const URLRequestBufferJob::HeadersMap& headers) {
+  for (URLRequestBufferJob::HeadersMap::const_iterator it = headers.begin();
+       it != headers.end(); ++it)
+    if (LowerCaseEqualsASCII(it->first, "cache-control") &&
+        StringToLowerASCII(it->second).find("no-store") != std::string::npos)
+      return true;
+  return false;
+}
+
+// Reads the file served by a RequestFileJob in the blocking pool, and puts it
+// into the response cache, so later requests do not touch the disk. Files
+// larger than |max_size| are not read at all.
+void ReadFileIntoCache(scoped_refptr<ProtocolResponseCache> cache,
+                       const GURL& url,
+                       int generation,
+                       size_t max_size,
+                       const base::FilePath& path) {
+  int64 file_size;
+  if (!base::GetFileSize(path, &file_size) ||
+      static_cast<uint64>(file_size) > max_size)
+    return;
+
+  std::string content;
+  if (!base::ReadFileToString(path, &content, max_size))
+    return;
+
+  ProtocolResponseCache::Entry entry;
+  net::GetMimeTypeFromFile(path, &entry.mime_type);
+  entry.data = base::RefCountedString::TakeString(&content);
+  BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+      base::Bind(&ProtocolResponseCache::Put, cache, url, generation, entry));
+}
+
+// Feeds a URLRequestStreamJob with the data written from JS. Like node's
+// writable streams, write() returns false when too much data is waiting to be
+// read, and the "drain" event is emitted when the writer can continue.
+//
+// The sink keeps itself alive until all the data has been handed to the job
+// or the job is killed, otherwise the data written before the job starts
+// would be lost when the sink is garbage collected.
+class StreamSink : public mate::EventEmitter,
+                   public URLRequestStreamJob::Source {
  public:
-  CustomProtocolRequestJob(Protocol* registry,
-                           ProtocolHandler* protocol_handler,
-                           net::URLRequest* request,
-                           net::NetworkDelegate* network_delegate)
-      : AdapterRequestJob(protocol_handler, request, network_delegate),
-        registry_(registry) {
+  static mate::Handle<StreamSink> Create(v8::Isolate* isolate) {
+    mate::Handle<StreamSink> handle = CreateHandle(isolate, new StreamSink);
+    handle->self_.reset(isolate, handle.ToV8()->ToObject());
+    return handle;
   }
 
-  // AdapterRequestJob:
-  virtual void GetJobTypeInUI() OVERRIDE {
-    DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  base::WeakPtr<URLRequestStreamJob::Source> GetWeakPtr() {
+    return weak_factory_.GetWeakPtr();
+  }
 
-    v8::Isolate* isolate = v8::Isolate::GetCurrent();
-    v8::Locker locker(isolate);
-    v8::HandleScope handle_scope(isolate);
+  // Called when no job will ever use the sink.
+  void Discard() {
+    self_.reset();
+  }
 
-    // Call the JS handler.
-    Protocol::JsProtocolHandler callback =
-        registry_->GetProtocolHandler(request()->url().scheme());
-    v8::Handle<v8::Value> result = callback.Run(request());
+  // URLRequestStreamJob::Source:
+  virtual void OnJobStarted(base::WeakPtr<URLRequestStreamJob> job) OVERRIDE {
+    job_ = job;
+    started_ = true;
+    for (size_t i = 0; i < pending_chunks_.size(); ++i)
+      PostData(pending_chunks_[i]);
+    pending_chunks_.clear();
+    if (ended_) {
+      PostEnd();
+      self_.reset();
+    }
+  }
+
+  virtual void OnDataConsumed(int bytes) OVERRIDE {
+    buffered_size_ -= bytes;
+    if (needs_drain_ && buffered_size_ < kHighWaterMark) {
+      needs_drain_ = false;
+      Emit("drain");
+    }
+  }
+
+  virtual void OnJobKilled() OVERRIDE {
+    Emit("abort");
+    self_.reset();
+  }
+
+ protected:
+  // mate::Wrappable implementations:
+  virtual mate::ObjectTemplateBuilder GetObjectTemplateBuilder(
+      v8::Isolate* isolate) OVERRIDE {
+    return mate::ObjectTemplateBuilder(isolate)
+        .SetMethod("write", &StreamSink::Write)
+        .SetMethod("end", &StreamSink::End)
+        .SetMethod("error", &StreamSink::Error);
+  }
+
+ private:
+  // The size of unread data that makes write() return false.
+  static const size_t kHighWaterMark = 1024 * 1024;
+
+  StreamSink()
+      : started_(false),
+        ended_(false),
+        error_(net::OK),
+        buffered_size_(0),
+        needs_drain_(false),
+        weak_factory_(this) {
+  }
+
+  bool Write(v8::Handle<v8::Value> buffer) {
+    if (!node::Buffer::HasInstance(buffer)) {
+      node::ThrowTypeError("Data should be Buffer");
+      return false;
+    }
+
+    std::string chunk(node::Buffer::Data(buffer),
+                      node::Buffer::Length(buffer));
+    buffered_size_ += chunk.size();
+    scoped_refptr<base::RefCountedString> data =
+        base::RefCountedString::TakeString(&chunk);
+    if (started_)
+      PostData(data);
+    else
+      pending_chunks_.push_back(data);
+
+    if (buffered_size_ >= kHighWaterMark) {
+      needs_drain_ = true;
+      return false;
+    }
+    return true;
+  }
+
+  void End() { Finish(net::OK); }
+  void Error() { Finish(net::ERR_FAILED); }
+
+  void Finish(int error) {
+    if (ended_)
+      return;
+    ended_ = true;
+    error_ = error;
+    if (started_) {
+      PostEnd();
+      self_.reset();
+    }
+  }
+
+  void PostData(scoped_refptr<base::RefCountedString> data) {
+    BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+        base::Bind(&URLRequestStreamJob::AppendData, job_, data));
+  }
+
+  void PostEnd() {
+    BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+        base::Bind(&URLRequestStreamJob::End, job_, error_));
+  }
+
+  // The strong reference to our wrapper.
+  mate::ScopedPersistent<v8::Object> self_;
+
+  base::WeakPtr<URLRequestStreamJob> job_;
+  bool started_;
+  bool ended_;
+  int error_;
+
+  // The data written before the job is started.
+  std::deque<scoped_refptr<base::RefCountedString> > pending_chunks_;
+
+  // The size of data that has been written but not read.
+  size_t buffered_size_;
+  bool needs_drain_;
+
+  base::WeakPtrFactory<StreamSink> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(StreamSink);
+};
+
+// Starts the stream job, or tells the sink that the request is gone so it can
+// stop keeping itself alive.
+void StartStreamJob(base::WeakPtr<AdapterRequestJob> job,
+                    const std::string& mime_type,
+                    const std::string& charset,
+                    base::WeakPtr<URLRequestStreamJob::Source> sink) {
+  if (job)
+    job->CreateStreamJobAndStart(mime_type, charset, sink);
+  else
+    BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
+        base::Bind(&URLRequestStreamJob::Source::OnJobKilled, sink));
+}
+
+// Creates the job returned by the JS handler. The handler can return the job
+// directly, or take a callback and pass the job to it later, in which case
+// the completer is kept by the callback until the job is sent.
+class RequestJobCompleter : public mate::Wrappable {
+ public:
+  static mate::Handle<RequestJobCompleter> Create(
+      v8::Isolate* isolate,
+      base::WeakPtr<AdapterRequestJob> job,
+      bool has_default_protocol_handler) {
+    return CreateHandle(isolate, new RequestJobCompleter(
+        job, has_default_protocol_handler));
+  }
+
+  // Starts the job described by |result| in IO thread, only the first call
+  // takes effect.
+  void Complete(v8::Isolate* isolate, v8::Handle<v8::Value> result) {
+    DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+    if (completed_)
+      return;
+    completed_ = true;
 
     // Determine the type of the job we are going to create.
     if (result->IsString()) {
       std::string data = mate::V8ToString(result);
+      CacheString("text/plain", "UTF-8", data);
       BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
           base::Bind(&AdapterRequestJob::CreateStringJobAndStart,
-                     GetWeakPtr(), "text/plain", "UTF-8", data));
+                     job_, "text/plain", "UTF-8", data));
       return;
     } else if (result->IsObject()) {
       v8::Handle<v8::Object> obj = result->ToObject();
@@ -84,37 +360,224 @@ class CustomProtocolRequestJob : public AdapterRequestJob {
         dict.Get("charset", &charset);
         dict.Get("data", &data);
 
+        CacheString(mime_type, charset, data);
         BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
             base::Bind(&AdapterRequestJob::CreateStringJobAndStart,
-                       GetWeakPtr(), mime_type, charset, data));
+                       job_, mime_type, charset, data));
+        return;
+      } else if (name == "RequestBufferJob") {
+        std::string mime_type, charset;
+        int status_code = 200;
+        URLRequestBufferJob::HeadersMap headers;
+        v8::Handle<v8::Value> buffer;
+        dict.Get("mimeType", &mime_type);
+        dict.Get("charset", &charset);
+        dict.Get("statusCode", &status_code);
+        v8::Handle<v8::Object> headers_object;
+        if (dict.Get("headers", &headers_object))
+          GetHeaders(headers_object, &headers);
+        if (!dict.Get("data", &buffer) || !node::Buffer::HasInstance(buffer)) {
+          BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+              base::Bind(&AdapterRequestJob::CreateErrorJobAndStart,
+                         job_, net::ERR_FAILED));
+          return;
+        }
+
+        std::string content(node::Buffer::Data(buffer),
+                            node::Buffer::Length(buffer));
+        scoped_refptr<base::RefCountedMemory> data =
+            base::RefCountedString::TakeString(&content);
+        if (status_code == 200 && !IsNoStore(headers))
+          CacheData(mime_type, charset, data, headers);
+        BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+            base::Bind(&AdapterRequestJob::CreateBufferJobAndStart,
+                       job_, mime_type, charset, data, status_code, headers));
         return;
       } else if (name == "RequestFileJob") {
         base::FilePath path;
         dict.Get("path", &path);
 
+        if (cache_)
+          BrowserThread::PostBlockingPoolTask(FROM_HERE,
+              base::Bind(&ReadFileIntoCache, cache_, url_, generation_,
+                         std::min(capacity_, kMaxCachedFileSize), path));
         BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
             base::Bind(&AdapterRequestJob::CreateFileJobAndStart,
-                       GetWeakPtr(), path));
+                       job_, path));
+        return;
+      } else if (name == "RequestStreamJob") {
+        std::string mime_type, charset;
+        dict.Get("mimeType", &mime_type);
+        dict.Get("charset", &charset);
+
+        // Let the JS side pipe its stream into the sink, it throws when the
+        // job has already been used.
+        mate::Handle<StreamSink> sink = StreamSink::Create(isolate);
+        base::Callback<void(mate::Handle<StreamSink>)> pipe;
+        v8::TryCatch try_catch;
+        if (dict.Get("_pipe", &pipe))
+          pipe.Run(sink);
+        if (try_catch.HasCaught()) {
+          sink->Discard();
+          BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+              base::Bind(&AdapterRequestJob::CreateErrorJobAndStart,
+                         job_, net::ERR_FAILED));
+          try_catch.ReThrow();
+          return;
+        }
+
+        BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+            base::Bind(&StartStreamJob,
+                       job_, mime_type, charset, sink->GetWeakPtr()));
         return;
       }
     }
 
     // Try the default protocol handler if we have.
-    if (default_protocol_handler()) {
+    if (has_default_protocol_handler_) {
       BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
           base::Bind(&AdapterRequestJob::CreateJobFromProtocolHandlerAndStart,
-                     GetWeakPtr()));
+                     job_));
       return;
     }
 
     // Fallback to the not implemented error.
     BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
         base::Bind(&AdapterRequestJob::CreateErrorJobAndStart,
-                   GetWeakPtr(), net::ERR_NOT_IMPLEMENTED));
+                   job_, net::ERR_NOT_IMPLEMENTED));
+  }
+
+  // Called by the JS handler when it will complete the request later.
+  void Defer() { deferred_ = true; }
+
+  // Puts the response into |cache| when the job is created, the |generation|
+  // and |capacity| should be taken when the request is started.
+  void SetCache(scoped_refptr<ProtocolResponseCache> cache,
+                int generation,
+                size_t capacity,
+                const GURL& url) {
+    cache_ = cache;
+    generation_ = generation;
+    capacity_ = capacity;
+    url_ = url;
+  }
+
+  bool deferred() const { return deferred_; }
+
+ protected:
+  virtual ~RequestJobCompleter() {
+    // The handler has dropped the callback without calling it.
+    if (!completed_)
+      BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+          base::Bind(&AdapterRequestJob::CreateErrorJobAndStart,
+                     job_, net::ERR_FAILED));
+  }
+
+  // mate::Wrappable implementations:
+  virtual mate::ObjectTemplateBuilder GetObjectTemplateBuilder(
+      v8::Isolate* isolate) OVERRIDE {
+    return mate::ObjectTemplateBuilder(isolate)
+        .SetMethod("complete", &RequestJobCompleter::Complete)
+        .SetMethod("defer", &RequestJobCompleter::Defer);
+  }
+
+ private:
+  RequestJobCompleter(base::WeakPtr<AdapterRequestJob> job,
+                      bool has_default_protocol_handler)
+      : job_(job),
+        has_default_protocol_handler_(has_default_protocol_handler),
+        deferred_(false),
+        completed_(false),
+        generation_(0),
+        capacity_(0) {
+  }
+
+  void CacheString(const std::string& mime_type,
+                   const std::string& charset,
+                   const std::string& data) {
+    if (!cache_)
+      return;
+    std::string copy(data);
+    CacheData(mime_type, charset, base::RefCountedString::TakeString(&copy),
+              URLRequestBufferJob::HeadersMap());
+  }
+
+  void CacheData(const std::string& mime_type,
+                 const std::string& charset,
+                 scoped_refptr<base::RefCountedMemory> data,
+                 const URLRequestBufferJob::HeadersMap& headers) {
+    if (!cache_)
+      return;
+    ProtocolResponseCache::Entry entry;
+    entry.mime_type = mime_type;
+    entry.charset = charset;
+    entry.data = data;
+    entry.headers = headers;
+    BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+        base::Bind(&ProtocolResponseCache::Put, cache_, url_, generation_,
+                   entry));
+  }
+
+  base::WeakPtr<AdapterRequestJob> job_;
+  bool has_default_protocol_handler_;
+  bool deferred_;
+  bool completed_;
+
+  // The cache to put the response in, NULL when it should not be cached.
+  scoped_refptr<ProtocolResponseCache> cache_;
+  int generation_;
+  size_t capacity_;
+  GURL url_;
+
+  DISALLOW_COPY_AND_ASSIGN(RequestJobCompleter);
+};
+
+class CustomProtocolRequestJob : public AdapterRequestJob {
+ public:
+  CustomProtocolRequestJob(Protocol* registry,
+                           ProtocolHandler* protocol_handler,
+                           ProtocolResponseCache* cache,
+                           net::URLRequest* request,
+                           net::NetworkDelegate* network_delegate)
+      : AdapterRequestJob(protocol_handler, request, network_delegate),
+        registry_(registry),
+        cache_(cache),
+        cache_generation_(cache ? cache->generation() : 0),
+        cache_capacity_(cache ? cache->capacity() : 0) {
+  }
+
+  // AdapterRequestJob:
+  virtual void GetJobTypeInUI() OVERRIDE {
+    DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+
+    v8::Isolate* isolate = v8::Isolate::GetCurrent();
+    v8::Locker locker(isolate);
+    v8::HandleScope handle_scope(isolate);
+
+    // Call the JS handler.
+    mate::Handle<RequestJobCompleter> completer = RequestJobCompleter::Create(
+        isolate, GetWeakPtr(), default_protocol_handler() != NULL);
+    if (cache_)
+      completer->SetCache(cache_, cache_generation_, cache_capacity_,
+                          request()->url());
+    Protocol::JsProtocolHandler callback =
+        registry_->GetProtocolHandler(request()->url().scheme());
+    v8::Handle<v8::Value> result = callback.Run(request(), completer.ToV8());
+
+    // The handler would pass the job to its callback later.
+    if (completer->deferred())
+      return;
+
+    completer->Complete(isolate, result);
   }
 
  private:
   Protocol* registry_;  // Weak, the Protocol class is expected to live forever.
+
+  // The response cache of the scheme, NULL when the response is not cacheable.
+  scoped_refptr<ProtocolResponseCache> cache_;
+  int cache_generation_;
+  size_t cache_capacity_;
 };
 
 // Always return the same CustomProtocolRequestJob for all requests, because
@@ -127,16 +590,64 @@ class CustomProtocolHandler : public ProtocolHandler {
  public:
   CustomProtocolHandler(api::Protocol* registry,
                         ProtocolHandler* protocol_handler = NULL)
-      : registry_(registry), protocol_handler_(protocol_handler) {
+      : registry_(registry),
+        protocol_handler_(protocol_handler),
+        cache_(new ProtocolResponseCache) {
   }
 
   virtual net::URLRequestJob* MaybeCreateJob(
       net::URLRequest* request,
       net::NetworkDelegate* network_delegate) const OVERRIDE {
+    net::URLRequestJob* job = MaybeCreateStaticJob(request, network_delegate);
+    if (job)
+      return job;
+
+    // Only the responses of GET requests are cached.
+    bool cacheable = cache_->enabled() && request->method() == "GET";
+    if (cacheable) {
+      const ProtocolResponseCache::Entry* entry = cache_->Get(request->url());
+      if (entry)
+        return new URLRequestBufferJob(request, network_delegate,
+                                       entry->mime_type, entry->charset,
+                                       entry->data, 200, entry->headers);
+    }
+
     return new CustomProtocolRequestJob(registry_, protocol_handler_.get(),
+                                        cacheable ? cache_.get() : NULL,
                                         request, network_delegate);
   }
 
+  ProtocolResponseCache* cache() { return cache_.get(); }
+
+  // The static routes are answered in IO thread without calling the JS
+  // handler, they can only be changed in IO thread.
+  void SetBuffer(const std::string& path,
+                 const std::string& mime_type,
+                 const std::string& charset,
+                 scoped_refptr<base::RefCountedMemory> data) {
+    DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+    StaticBuffer& buffer = buffers_[path];
+    buffer.mime_type = mime_type;
+    buffer.charset = charset;
+    buffer.data = data;
+  }
+
+  void RemoveBuffer(const std::string& path) {
+    DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+    buffers_.erase(path);
+  }
+
+  void MapDirectory(const std::string& prefix,
+                    const base::FilePath& directory) {
+    DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+    directories_[prefix] = directory;
+  }
+
+  void UnmapDirectory(const std::string& prefix) {
+    DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+    directories_.erase(prefix);
+  }
+
   ProtocolHandler* ReleaseDefaultProtocolHandler() {
     return protocol_handler_.release();
   }
@@ -144,12 +655,150 @@ class CustomProtocolHandler : public ProtocolHandler {
   ProtocolHandler* original_handler() { return protocol_handler_.get(); }
 
  private:
+  struct StaticBuffer {
+    std::string mime_type;
+    std::string charset;
+    scoped_refptr<base::RefCountedMemory> data;
+  };
+
+  typedef std::map<std::string, StaticBuffer> BuffersMap;
+  typedef std::map<std::string, base::FilePath> DirectoriesMap;
+
+  // Returns a job for the request if it matches a static route, otherwise
+  // returns NULL so the JS handler is asked.
+  net::URLRequestJob* MaybeCreateStaticJob(
+      net::URLRequest* request,
+      net::NetworkDelegate* network_delegate) const {
+    if (buffers_.empty() && directories_.empty())
+      return NULL;
+
+    std::string path = GetStaticRoutePath(request->url());
+    BuffersMap::const_iterator buffer = buffers_.find(path);
+    if (buffer != buffers_.end())
+      return new URLRequestBufferJob(request, network_delegate,
+                                     buffer->second.mime_type,
+                                     buffer->second.charset,
+                                     buffer->second.data,
+                                     200,
+                                     URLRequestBufferJob::HeadersMap());
+
+    // Iterating in reverse order makes "a/b" match before "a". Whether the
+    // file exists can not be checked without blocking IO thread, so the
+    // mapped directory is authoritative for all paths under the prefix.
+    for (DirectoriesMap::const_reverse_iterator it = directories_.rbegin();
+         it != directories_.rend(); ++it) {
+      const std::string& prefix = it->first;
+      std::string relative;
+      if (prefix.empty())
+        relative = path;
+      else if (path == prefix)
+        relative = std::string();
+      else if (StartsWithASCII(path, prefix + "/", true))
+        relative = path.substr(prefix.size() + 1);
+      else
+        continue;
+
+      base::FilePath relative_path = base::FilePath::FromUTF8Unsafe(relative);
+      if (relative_path.IsAbsolute() || relative_path.ReferencesParent())
+        return new net::URLRequestErrorJob(request, network_delegate,
+                                           net::ERR_ACCESS_DENIED);
+
+      return new net::URLRequestFileJob(
+          request,
+          network_delegate,
+          relative.empty() ? it->second : it->second.Append(relative_path),
+          BrowserThread::GetBlockingPool()->
+              GetTaskRunnerWithShutdownBehavior(
+                  base::SequencedWorkerPool::SKIP_ON_SHUTDOWN));
+    }
+
+    return NULL;
+  }
+
   Protocol* registry_;  // Weak, the Protocol class is expected to live forever.
   scoped_ptr<ProtocolHandler> protocol_handler_;
 
+  BuffersMap buffers_;
+  DirectoriesMap directories_;
+
+  scoped_refptr<ProtocolResponseCache> cache_;
+
   DISALLOW_COPY_AND_ASSIGN(CustomProtocolHandler);
 };
 
+// Returns the CustomProtocolHandler of |scheme|, or NULL when the scheme has
+// been unregistered in IO thread.
+CustomProtocolHandler* GetCustomProtocolHandler(
+    AtomURLRequestJobFactory* job_factory, const std::string& scheme) {
+  return static_cast<CustomProtocolHandler*>(
+      job_factory->GetProtocolHandler(scheme));
+}
+
+void SetBufferInIO(AtomURLRequestJobFactory* job_factory,
+                   const std::string& scheme,
+                   const std::string& path,
+                   const std::string& mime_type,
+                   const std::string& charset,
+                   scoped_refptr<base::RefCountedMemory> data) {
+  CustomProtocolHandler* handler = GetCustomProtocolHandler(job_factory,
+                                                            scheme);
+  if (handler)
+    handler->SetBuffer(path, mime_type, charset, data);
+}
+
+void RemoveBufferInIO(AtomURLRequestJobFactory* job_factory,
+                      const std::string& scheme,
+                      const std::string& path) {
+  CustomProtocolHandler* handler = GetCustomProtocolHandler(job_factory,
+                                                            scheme);
+  if (handler)
+    handler->RemoveBuffer(path);
+}
+
+void MapDirectoryInIO(AtomURLRequestJobFactory* job_factory,
+                      const std::string& scheme,
+                      const std::string& prefix,
+                      const base::FilePath& directory) {
+  CustomProtocolHandler* handler = GetCustomProtocolHandler(job_factory,
+                                                            scheme);
+  if (handler)
+    handler->MapDirectory(prefix, directory);
+}
+
+void UnmapDirectoryInIO(AtomURLRequestJobFactory* job_factory,
+                        const std::string& scheme,
+                        const std::string& prefix) {
+  CustomProtocolHandler* handler = GetCustomProtocolHandler(job_factory,
+                                                            scheme);
+  if (handler)
+    handler->UnmapDirectory(prefix);
+}
+
+void SetCacheSizeInIO(AtomURLRequestJobFactory* job_factory,
+                      const std::string& scheme,
+                      size_t size) {
+  CustomProtocolHandler* handler = GetCustomProtocolHandler(job_factory,
+                                                            scheme);
+  if (handler)
+    handler->cache()->SetCapacity(size);
+}
+
+void InvalidateCacheInIO(AtomURLRequestJobFactory* job_factory,
+                         const GURL& url) {
+  CustomProtocolHandler* handler = GetCustomProtocolHandler(job_factory,
+                                                            url.scheme());
+  if (handler)
+    handler->cache()->Remove(url);
+}
+
+void ClearCacheInIO(AtomURLRequestJobFactory* job_factory,
+                    const std::string& scheme) {
+  CustomProtocolHandler* handler = GetCustomProtocolHandler(job_factory,
+                                                            scheme);
+  if (handler)
+    handler->cache()->Clear();
+}
+
 }  // namespace
 
 Protocol::Protocol() : job_factory_(
@@ -178,7 +827,23 @@ mate::ObjectTemplateBuilder Protocol::GetObjectTemplateBuilder(
                             base::Unretained(this)))
       .SetMethod("uninterceptProtocol",
                  base::Bind(&Protocol::UninterceptProtocol,
-                            base::Unretained(this)));
+                            base::Unretained(this)))
+      .SetMethod("_setBuffer",
+                 base::Bind(&Protocol::SetBuffer, base::Unretained(this)))
+      .SetMethod("removeBuffer",
+                 base::Bind(&Protocol::RemoveBuffer, base::Unretained(this)))
+      .SetMethod("mapDirectory",
+                 base::Bind(&Protocol::MapDirectory, base::Unretained(this)))
+      .SetMethod("unmapDirectory",
+                 base::Bind(&Protocol::UnmapDirectory,
+                            base::Unretained(this)))
+      .SetMethod("setCacheSize",
+                 base::Bind(&Protocol::SetCacheSize, base::Unretained(this)))
+      .SetMethod("invalidateCache",
+                 base::Bind(&Protocol::InvalidateCache,
+                            base::Unretained(this)))
+      .SetMethod("clearCache",
+                 base::Bind(&Protocol::ClearCache, base::Unretained(this)));
 }
 
 void Protocol::RegisterProtocol(const std::string& scheme,
@@ -237,6 +902,96 @@ void Protocol::UninterceptProtocol(const std::string& scheme) {
                                      base::Unretained(this), scheme));
 }
 
+void Protocol::SetBuffer(const std::string& scheme,
+                         const std::string& path,
+                         v8::Handle<v8::Value> buffer,
+                         const std::string& mime_type,
+                         const std::string& charset) {
+  if (!ContainsKey(protocol_handlers_, scheme))
+    return node::ThrowError("The scheme has not been registered");
+  if (!node::Buffer::HasInstance(buffer))
+    return node::ThrowTypeError("Data should be Buffer");
+
+  // The data is copied once here and then shared by all requests.
+  std::string content(node::Buffer::Data(buffer),
+                      node::Buffer::Length(buffer));
+  scoped_refptr<base::RefCountedMemory> data =
+      base::RefCountedString::TakeString(&content);
+  BrowserThread::PostTask(BrowserThread::IO,
+                          FROM_HERE,
+                          base::Bind(&SetBufferInIO, job_factory_, scheme,
+                                     NormalizeStaticRoutePath(path),
+                                     mime_type, charset, data));
+}
+
+void Protocol::RemoveBuffer(const std::string& scheme,
+                            const std::string& path) {
+  if (!ContainsKey(protocol_handlers_, scheme))
+    return node::ThrowError("The scheme has not been registered");
+
+  BrowserThread::PostTask(BrowserThread::IO,
+                          FROM_HERE,
+                          base::Bind(&RemoveBufferInIO, job_factory_, scheme,
+                                     NormalizeStaticRoutePath(path)));
+}
+
+void Protocol::MapDirectory(const std::string& scheme,
+                            const std::string& prefix,
+                            const base::FilePath& directory) {
+  if (!ContainsKey(protocol_handlers_, scheme))
+    return node::ThrowError("The scheme has not been registered");
+  if (!directory.IsAbsolute())
+    return node::ThrowError("The directory should be an absolute path");
+
+  BrowserThread::PostTask(BrowserThread::IO,
+                          FROM_HERE,
+                          base::Bind(&MapDirectoryInIO, job_factory_, scheme,
+                                     NormalizeStaticRoutePrefix(prefix),
+                                     directory));
+}
+
+void Protocol::UnmapDirectory(const std::string& scheme,
+                              const std::string& prefix) {
+  if (!ContainsKey(protocol_handlers_, scheme))
+    return node::ThrowError("The scheme has not been registered");
+
+  BrowserThread::PostTask(BrowserThread::IO,
+                          FROM_HERE,
+                          base::Bind(&UnmapDirectoryInIO, job_factory_, scheme,
+                                     NormalizeStaticRoutePrefix(prefix)));
+}
+
+void Protocol::SetCacheSize(const std::string& scheme, double size) {
+  if (!ContainsKey(protocol_handlers_, scheme))
+    return node::ThrowError("The scheme has not been registered");
+  if (!base::IsFinite(size) || size < 0)
+    return node::ThrowError("The size should be a non-negative number");
+
+  BrowserThread::PostTask(BrowserThread::IO,
+                          FROM_HERE,
+                          base::Bind(&SetCacheSizeInIO, job_factory_, scheme,
+                                     static_cast<size_t>(size)));
+}
+
+void Protocol::InvalidateCache(const std::string& url) {
+  GURL gurl(url);
+  if (!ContainsKey(protocol_handlers_, gurl.scheme()))
+    return node::ThrowError("The scheme has not been registered");
+
+  BrowserThread::PostTask(BrowserThread::IO,
+                          FROM_HERE,
+                          base::Bind(&InvalidateCacheInIO, job_factory_, gurl));
+}
+
+void Protocol::ClearCache(const std::string& scheme) {
+  if (!ContainsKey(protocol_handlers_, scheme))
+    return node::ThrowError("The scheme has not been registered");
+
+  BrowserThread::PostTask(BrowserThread::IO,
+                          FROM_HERE,
+                          base::Bind(&ClearCacheInIO, job_factory_, scheme));
+}
+
 void Protocol::RegisterProtocolInIO(const std::string& scheme) {
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
 
@@ -12,6 +12,10 @@
 #include "base/callback.h"
 #include "native_mate/handle.h"
 
+namespace base {
+class FilePath;
+}
+
 namespace net {
 class URLRequest;
 }
@@ -24,7 +28,10 @@ namespace api {
 
 class Protocol : public mate::EventEmitter {
  public:
-  typedef base::Callback<v8::Handle<v8::Value>(const net::URLRequest*)>
+  // The handler is called with the request and a completer, which is used by
+  // asynchronous handlers to send the job later.
+  typedef base::Callback<v8::Handle<v8::Value>(const net::URLRequest*,
+                                               v8::Handle<v8::Value>)>
           JsProtocolHandler;
 
   static mate::Handle<Protocol> Create(v8::Isolate* isolate);
@@ -57,6 +64,30 @@ class Protocol : public mate::EventEmitter {
                          const JsProtocolHandler& callback);
   void UninterceptProtocol(const std::string& scheme);
 
+  // Serves |buffer| for the requests to "scheme://path" without calling the
+  // JS handler.
+  void SetBuffer(const std::string& scheme,
+                 const std::string& path,
+                 v8::Handle<v8::Value> buffer,
+                 const std::string& mime_type,
+                 const std::string& charset);
+  void RemoveBuffer(const std::string& scheme, const std::string& path);
+
+  // Serves the files under |directory| for the requests to
+  // "scheme://prefix/..." without calling the JS handler.
+  void MapDirectory(const std::string& scheme,
+                    const std::string& prefix,
+                    const base::FilePath& directory);
+  void UnmapDirectory(const std::string& scheme, const std::string& prefix);
+
+  // Caches up to |size| bytes of the responses of |scheme| in memory, 0
+  // disables the cache.
+  void SetCacheSize(const std::string& scheme, double size);
+
+  // Removes the cached response of |url|, or all responses of |scheme|.
+  void InvalidateCache(const std::string& url);
+  void ClearCache(const std::string& scheme);
+
   // The networking related operations have to be done in IO thread.
   void RegisterProtocolInIO(const std::string& scheme);
   void UnregisterProtocolInIO(const std::string& scheme);
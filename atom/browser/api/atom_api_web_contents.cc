@@ -4,11 +4,15 @@
 
 #include "atom/browser/api/atom_api_web_contents.h"
 
+#include "atom/browser/native_window.h"
 #include "atom/common/api/api_messages.h"
 #include "atom/common/native_mate_converters/gurl_converter.h"
 #include "atom/common/native_mate_converters/string16_converter.h"
+#include "atom/common/native_mate_converters/v8_value_serializer.h"
 #include "atom/common/native_mate_converters/value_converter.h"
 #include "base/strings/utf_string_conversions.h"
+#include "content/public/browser/navigation_controller.h"
+#include "content/public/browser/navigation_details.h"
 #include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/render_process_host.h"
 #include "content/public/browser/render_view_host.h"
@@ -31,6 +35,14 @@ void WebContents::RenderViewDeleted(content::RenderViewHost* render_view_host) {
   Emit("render-view-deleted", args);
 }
 
+void WebContents::DidNavigateMainFrame(
+    const content::LoadCommittedDetails& details,
+    const content::FrameNavigateParams& params) {
+  base::ListValue args;
+  args.AppendBoolean(details.is_in_page);
+  Emit("did-navigate-main-frame", args);
+}
+
 void WebContents::RenderProcessGone(base::TerminationStatus status) {
   Emit("crashed");
 }
@@ -59,8 +71,12 @@ bool WebContents::OnMessageReceived(const IPC::Message& message) {
   bool handled = true;
   IPC_BEGIN_MESSAGE_MAP(WebContents, message)
     IPC_MESSAGE_HANDLER(AtomViewHostMsg_Message, OnRendererMessage)
+    IPC_MESSAGE_HANDLER(AtomViewHostMsg_Message_Serialized,
+                        OnRendererMessageSerialized)
     IPC_MESSAGE_HANDLER_DELAY_REPLY(AtomViewHostMsg_Message_Sync,
                                     OnRendererMessageSync)
+    IPC_MESSAGE_HANDLER_DELAY_REPLY(AtomViewHostMsg_Message_Sync_Serialized,
+                                    OnRendererMessageSyncSerialized)
     IPC_MESSAGE_UNHANDLED(handled = false)
   IPC_END_MESSAGE_MAP()
 
@@ -105,6 +121,16 @@ void WebContents::Stop() {
 }
 
 void WebContents::Reload() {
+  // Windows that reuse renderer process can reload in place, since the node
+  // environment of the page is recreated without restarting the process.
+  content::RenderViewHost* host = web_contents()->GetRenderViewHost();
+  NativeWindow* window = NativeWindow::FromRenderView(
+      host->GetProcess()->GetID(), host->GetRoutingID());
+  if (window && window->reuse_renderer_process()) {
+    web_contents()->GetController().Reload(false);
+    return;
+  }
+
   // Navigating to a URL would always restart the renderer process, we want this
   // because normal reloading will break our node integration.
   // This is done by AtomBrowserClient::ShouldSwapProcessesForNavigation.
@@ -159,9 +185,20 @@ void WebContents::ExecuteJavaScript(const base::string16& code) {
   web_contents()->GetMainFrame()->ExecuteJavaScript(code);
 }
 
-bool WebContents::SendIPCMessage(const base::string16& channel,
-                                 const base::ListValue& args) {
-  return Send(new AtomViewMsg_Message(routing_id(), channel, args));
+bool WebContents::SendIPCMessage(v8::Isolate* isolate,
+                                 const base::string16& channel,
+                                 v8::Handle<v8::Value> args) {
+  std::string serialized;
+  V8ValueSerializer serializer;
+  if (serializer.Serialize(args, &serialized))
+    return Send(new AtomViewMsg_Message_Serialized(
+        routing_id(), channel, serialized));
+
+  // Fallback to base::ListValue for values the serializer can not handle.
+  base::ListValue list;
+  if (!mate::ConvertFromV8(isolate, args, &list))
+    return false;
+  return Send(new AtomViewMsg_Message(routing_id(), channel, list));
 }
 
 mate::ObjectTemplateBuilder WebContents::GetObjectTemplateBuilder(
@@ -196,6 +233,14 @@ void WebContents::OnRendererMessage(const base::string16& channel,
   Emit(base::UTF16ToUTF8(channel), args, web_contents(), NULL);
 }
 
+void WebContents::OnRendererMessageSerialized(
+    const base::string16& channel,
+    const std::string& serialized_args) {
+  // webContents.emit(channel, new Event(), args...);
+  EmitSerialized(base::UTF16ToUTF8(channel), serialized_args, web_contents(),
+                 NULL);
+}
+
 void WebContents::OnRendererMessageSync(const base::string16& channel,
                                         const base::ListValue& args,
                                         IPC::Message* message) {
@@ -203,6 +248,15 @@ void WebContents::OnRendererMessageSync(const base::string16& channel,
   Emit(base::UTF16ToUTF8(channel), args, web_contents(), message);
 }
 
+void WebContents::OnRendererMessageSyncSerialized(
+    const base::string16& channel,
+    const std::string& serialized_args,
+    IPC::Message* message) {
+  // webContents.emit(channel, new Event(sender, message), args...);
+  EmitSerialized(base::UTF16ToUTF8(channel), serialized_args, web_contents(),
+                 message);
+}
+
 // static
 mate::Handle<WebContents> WebContents::Create(
     v8::Isolate* isolate, content::WebContents* web_contents) {
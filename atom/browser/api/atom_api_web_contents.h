@@ -5,6 +5,8 @@
 #ifndef ATOM_BROWSER_API_ATOM_API_WEB_CONTENTS_H_
 #define ATOM_BROWSER_API_ATOM_API_WEB_CONTENTS_H_
 
+#include <string>
+
 #include "atom/browser/api/event_emitter.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "native_mate/handle.h"
@@ -39,8 +41,9 @@ class WebContents : public mate::EventEmitter,
   int GetProcessID() const;
   bool IsCrashed() const;
   void ExecuteJavaScript(const base::string16& code);
-  bool SendIPCMessage(const base::string16& channel,
-                      const base::ListValue& args);
+  bool SendIPCMessage(v8::Isolate* isolate,
+                      const base::string16& channel,
+                      v8::Handle<v8::Value> args);
 
  protected:
   explicit WebContents(content::WebContents* web_contents);
@@ -52,6 +55,9 @@ class WebContents : public mate::EventEmitter,
   // content::WebContentsObserver implementations:
   virtual void RenderViewDeleted(content::RenderViewHost*) OVERRIDE;
   virtual void RenderProcessGone(base::TerminationStatus status) OVERRIDE;
+  virtual void DidNavigateMainFrame(
+      const content::LoadCommittedDetails& details,
+      const content::FrameNavigateParams& params) OVERRIDE;
   virtual void DidFinishLoad(
       int64 frame_id,
       const GURL& validated_url,
@@ -69,11 +75,21 @@ class WebContents : public mate::EventEmitter,
   void OnRendererMessage(const base::string16& channel,
                          const base::ListValue& args);
 
+  // Called when received a message with serialized arguments from renderer.
+  void OnRendererMessageSerialized(const base::string16& channel,
+                                   const std::string& serialized_args);
+
   // Called when received a synchronous message from renderer.
   void OnRendererMessageSync(const base::string16& channel,
                              const base::ListValue& args,
                              IPC::Message* message);
 
+  // Called when received a synchronous message with serialized arguments from
+  // renderer.
+  void OnRendererMessageSyncSerialized(const base::string16& channel,
+                                       const std::string& serialized_args,
+                                       IPC::Message* message);
+
   content::WebContents* web_contents_;  // Weak.
 
   DISALLOW_COPY_AND_ASSIGN(WebContents);
@@ -4,8 +4,13 @@
 
 #include "atom/browser/api/event.h"
 
+#include <string>
+
 #include "atom/common/api/api_messages.h"
 #include "atom/common/native_mate_converters/string16_converter.h"
+#include "atom/common/native_mate_converters/v8_value_serializer.h"
+#include "base/logging.h"
+#include "base/strings/utf_string_conversions.h"
 #include "content/public/browser/web_contents.h"
 #include "native_mate/object_template_builder.h"
 
@@ -45,11 +50,41 @@ void Event::PreventDefault() {
   prevent_default_ = true;
 }
 
-bool Event::SendReply(const base::string16& json) {
+bool Event::SendReply(v8::Isolate* isolate, v8::Handle<v8::Value> result) {
   if (message_ == NULL || sender_ == NULL)
     return false;
 
-  AtomViewHostMsg_Message_Sync::WriteReplyParams(message_, json);
+  v8::HandleScope handle_scope(isolate);
+  v8::Handle<v8::Context> context = isolate->GetCurrentContext();
+  atom::V8ValueSerializer serializer;
+
+  if (message_->type() == AtomViewHostMsg_Message_Sync_Serialized::ID) {
+    // Keep the semantics of JSON.stringify that the legacy reply has, and
+    // reply null when it would throw.
+    std::string serialized;
+    serializer.SetJSONCompatible(true);
+    if (!serializer.Serialize(result, &serialized)) {
+      LOG(ERROR) << "Unable to serialize the reply of synchronous message";
+      serializer.Serialize(v8::Null(isolate), &serialized);
+    }
+    AtomViewHostMsg_Message_Sync_Serialized::WriteReplyParams(message_,
+                                                              serialized);
+  } else {
+    // The legacy synchronous message expects the result of JSON.stringify,
+    // which honors toJSON and converts dates to strings.
+    base::string16 json = base::ASCIIToUTF16("null");
+    v8::Handle<v8::Object> json_object =
+        context->Global()->Get(StringToV8(isolate, "JSON"))->ToObject();
+    v8::Handle<v8::Function> stringify = v8::Handle<v8::Function>::Cast(
+        json_object->Get(StringToV8(isolate, "stringify")));
+    v8::Handle<v8::Value> argv[] = { result };
+    v8::TryCatch try_catch;
+    v8::Handle<v8::Value> string = stringify->Call(json_object, 1, argv);
+    if (!try_catch.HasCaught() && string->IsString())
+      ConvertFromV8(isolate, string, &json);
+    AtomViewHostMsg_Message_Sync::WriteReplyParams(message_, json);
+  }
+
   return sender_->Send(message_);
 }
 
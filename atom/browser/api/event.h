@@ -26,8 +26,8 @@ class Event : public Wrappable,
   // event.PreventDefault().
   void PreventDefault();
 
-  // event.sendReply(json), used for replying synchronous message.
-  bool SendReply(const base::string16& json);
+  // event.sendReply(result), used for replying synchronous message.
+  bool SendReply(v8::Isolate* isolate, v8::Handle<v8::Value> result);
 
   // Whether event.preventDefault() is called.
   bool prevent_default() const { return prevent_default_; }
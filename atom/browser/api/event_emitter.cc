@@ -8,6 +8,8 @@
 
 #include "atom/browser/api/event.h"
 #include "atom/common/native_mate_converters/v8_value_converter.h"
+#include "atom/common/native_mate_converters/v8_value_serializer.h"
+#include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/values.h"
 
@@ -38,20 +40,50 @@ bool EventEmitter::Emit(const base::StringPiece& name,
   v8::Handle<v8::Context> context = isolate->GetCurrentContext();
   scoped_ptr<atom::V8ValueConverter> converter(new atom::V8ValueConverter);
 
+  ValueArray v8_args;
+  v8_args.reserve(args.GetSize());
+  for (size_t i = 0; i < args.GetSize(); i++) {
+    const base::Value* value(NULL);
+    if (args.Get(i, &value))
+      v8_args.push_back(converter->ToV8Value(value, context));
+  }
+
+  return CallEmit(isolate, name, sender, message, &v8_args);
+}
+
+bool EventEmitter::EmitSerialized(const base::StringPiece& name,
+                                  const std::string& serialized_args,
+                                  content::WebContents* sender,
+                                  IPC::Message* message) {
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+
+  ValueArray v8_args;
+  atom::V8ValueSerializer serializer;
+  if (!serializer.DeserializeArray(isolate, serialized_args, &v8_args)) {
+    LOG(ERROR) << "Invalid serialized arguments for event " << name;
+    return false;
+  }
+
+  return CallEmit(isolate, name, sender, message, &v8_args);
+}
+
+bool EventEmitter::CallEmit(v8::Isolate* isolate,
+                            const base::StringPiece& name,
+                            content::WebContents* sender,
+                            IPC::Message* message,
+                            ValueArray* args) {
   mate::Handle<mate::Event> event = mate::Event::Create(isolate);
   if (sender && message)
     event->SetSenderAndMessage(sender, message);
 
   // v8_args = [name, event, args...];
-  std::vector<v8::Handle<v8::Value>> v8_args;
-  v8_args.reserve(args.GetSize() + 2);
+  ValueArray v8_args;
+  v8_args.reserve(args->size() + 2);
   v8_args.push_back(mate::StringToV8(isolate, name));
   v8_args.push_back(event.ToV8());
-  for (size_t i = 0; i < args.GetSize(); i++) {
-    const base::Value* value(NULL);
-    if (args.Get(i, &value))
-      v8_args.push_back(converter->ToV8Value(value, context));
-  }
+  v8_args.insert(v8_args.end(), args->begin(), args->end());
 
   // this.emit.apply(this, v8_args);
   node::MakeCallback(isolate, GetWrapper(isolate), "emit", v8_args.size(),
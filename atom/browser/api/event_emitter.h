@@ -5,6 +5,9 @@
 #ifndef ATOM_BROWSER_API_EVENT_EMITTER_H_
 #define ATOM_BROWSER_API_EVENT_EMITTER_H_
 
+#include <string>
+#include <vector>
+
 #include "native_mate/wrappable.h"
 
 namespace base {
@@ -36,7 +39,22 @@ class EventEmitter : public Wrappable {
   bool Emit(const base::StringPiece& name, const base::ListValue& args,
             content::WebContents* sender, IPC::Message* message);
 
+  // this.emit(name, new Event(sender, message), args...), the |args| are
+  // deserialized from |serialized_args| by atom::V8ValueSerializer.
+  bool EmitSerialized(const base::StringPiece& name,
+                      const std::string& serialized_args,
+                      content::WebContents* sender, IPC::Message* message);
+
  private:
+  typedef std::vector<v8::Handle<v8::Value>> ValueArray;
+
+  // this.emit.apply(this, [name, event].concat(args));
+  bool CallEmit(v8::Isolate* isolate,
+                const base::StringPiece& name,
+                content::WebContents* sender,
+                IPC::Message* message,
+                ValueArray* args);
+
   DISALLOW_COPY_AND_ASSIGN(EventEmitter);
 };
 
@@ -9,6 +9,7 @@
 #include "atom/browser/atom_browser_main_parts.h"
 #include "atom/browser/atom_resource_dispatcher_host_delegate.h"
 #include "atom/browser/native_window.h"
+#include "atom/browser/renderer_process_pool.h"
 #include "atom/browser/net/atom_url_request_context_getter.h"
 #include "atom/browser/window_list.h"
 #include "content/public/browser/render_process_host.h"
@@ -99,8 +100,28 @@ bool AtomBrowserClient::ShouldSwapBrowsingInstancesForNavigation(
     content::SiteInstance* site_instance,
     const GURL& current_url,
     const GURL& new_url) {
-  if (site_instance->HasProcess())
-    dying_render_process_ = site_instance->GetProcess();
+  if (!site_instance->HasProcess())
+    return true;
+
+  // The first navigation of a window that got a spare renderer process should
+  // happen in that process.
+  content::RenderProcessHost* process = site_instance->GetProcess();
+  if (RendererProcessPool::GetInstance()->ClaimTakenProcess(process))
+    return false;
+
+  // Windows that opted in keep their renderer process when navigating inside
+  // the same origin, the node environment of the old page is disposed and a
+  // new one is created for the new page in the same process.
+  WindowList* list = WindowList::GetInstance();
+  WindowList::const_iterator iter = std::find_if(
+      list->begin(), list->end(), FindByProcessId(process->GetID()));
+  if (iter != list->end() &&
+      (*iter)->reuse_renderer_process() &&
+      current_url.is_valid() &&
+      current_url.GetOrigin() == new_url.GetOrigin())
+    return false;
+
+  dying_render_process_ = process;
 
   // Restart renderer process for all navigations, this relies on a patch to
   // Chromium: http://git.io/_PaNyg.
@@ -8,6 +8,7 @@
 #include "atom/browser/atom_browser_context.h"
 #include "atom/browser/browser.h"
 #include "atom/browser/javascript_environment.h"
+#include "atom/browser/renderer_process_pool.h"
 #include "atom/common/api/atom_bindings.h"
 #include "atom/common/node_bindings.h"
 #include "base/command_line.h"
@@ -87,4 +88,12 @@ void AtomBrowserMainParts::PreMainMessageLoopRun() {
 #endif
 }
 
+void AtomBrowserMainParts::PostMainMessageLoopRun() {
+  // The spare renderer processes hold the browser context, release them
+  // before it is destroyed.
+  RendererProcessPool::GetInstance()->Shutdown();
+
+  brightray::BrowserMainParts::PostMainMessageLoopRun();
+}
+
 }  // namespace atom
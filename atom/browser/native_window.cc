@@ -11,6 +11,7 @@
 #include "atom/browser/atom_browser_context.h"
 #include "atom/browser/atom_javascript_dialog_manager.h"
 #include "atom/browser/browser.h"
+#include "atom/browser/renderer_process_pool.h"
 #include "atom/browser/ui/file_dialog.h"
 #include "atom/browser/window_list.h"
 #include "atom/common/api/api_messages.h"
@@ -40,6 +41,7 @@
 #include "content/public/browser/render_process_host.h"
 #include "content/public/browser/render_view_host.h"
 #include "content/public/browser/render_widget_host_view.h"
+#include "content/public/browser/site_instance.h"
 #include "content/public/common/renderer_preferences.h"
 #include "content/public/common/user_agent.h"
 #include "ipc/ipc_message_macros.h"
@@ -62,6 +64,7 @@ NativeWindow::NativeWindow(content::WebContents* web_contents,
       node_integration_("except-iframe"),
       has_dialog_attached_(false),
       zoom_factor_(1.0),
+      reuse_renderer_process_(false),
       weak_factory_(this),
       inspectable_web_contents_(
           brightray::InspectableWebContents::Create(web_contents)) {
@@ -79,6 +82,9 @@ NativeWindow::NativeWindow(content::WebContents* web_contents,
   // Read the zoom factor before any navigation.
   options.Get(switches::kZoomFactor, &zoom_factor_);
 
+  // Read whether to reuse renderer process before any navigation.
+  options.Get(switches::kReuseRendererProcess, &reuse_renderer_process_);
+
   web_contents->SetDelegate(this);
   inspectable_web_contents()->SetDelegate(this);
 
@@ -107,7 +113,18 @@ NativeWindow::~NativeWindow() {
 
 // static
 NativeWindow* NativeWindow::Create(const mate::Dictionary& options) {
-  content::WebContents::CreateParams create_params(AtomBrowserContext::Get());
+  // The spare renderer processes are launched with default switches, so only
+  // windows using the default options can use them.
+  std::string node_integration("except-iframe");
+  double zoom_factor = 1.0;
+  options.Get(switches::kNodeIntegration, &node_integration);
+  options.Get(switches::kZoomFactor, &zoom_factor);
+  scoped_refptr<content::SiteInstance> site_instance;
+  if (node_integration == "except-iframe" && zoom_factor == 1.0)
+    site_instance = RendererProcessPool::GetInstance()->Take();
+
+  content::WebContents::CreateParams create_params(AtomBrowserContext::Get(),
+                                                   site_instance.get());
   return Create(content::WebContents::Create(create_params), options);
 }
 
@@ -191,6 +191,7 @@ class NativeWindow : public brightray::DefaultWebContentsDelegate,
   }
 
   bool has_frame() const { return has_frame_; }
+  bool reuse_renderer_process() const { return reuse_renderer_process_; }
 
   void set_has_dialog_attached(bool has_dialog_attached) {
     has_dialog_attached_ = has_dialog_attached;
@@ -297,6 +298,9 @@ class NativeWindow : public brightray::DefaultWebContentsDelegate,
   // Page's default zoom factor.
   double zoom_factor_;
 
+  // Whether to keep the renderer process for same origin navigations.
+  bool reuse_renderer_process_;
+
   base::WeakPtrFactory<NativeWindow> weak_factory_;
 
   scoped_ptr<AtomJavaScriptDialogManager> dialog_manager_;
@@ -63,6 +63,15 @@ bool AdapterRequestJob::GetCharset(std::string* charset) {
   return real_job_->GetCharset(charset);
 }
 
+void AdapterRequestJob::GetResponseInfo(net::HttpResponseInfo* info) {
+  if (real_job_)
+    real_job_->GetResponseInfo(info);
+}
+
+int AdapterRequestJob::GetResponseCode() const {
+  return real_job_ ? real_job_->GetResponseCode() : -1;
+}
+
 base::WeakPtr<AdapterRequestJob> AdapterRequestJob::GetWeakPtr() {
   return weak_factory_.GetWeakPtr();
 }
@@ -85,6 +94,19 @@ void AdapterRequestJob::CreateStringJobAndStart(const std::string& mime_type,
   real_job_->Start();
 }
 
+void AdapterRequestJob::CreateBufferJobAndStart(
+    const std::string& mime_type,
+    const std::string& charset,
+    scoped_refptr<base::RefCountedMemory> data,
+    int status_code,
+    const URLRequestBufferJob::HeadersMap& headers) {
+  DCHECK(content::BrowserThread::CurrentlyOn(content::BrowserThread::IO));
+
+  real_job_ = new URLRequestBufferJob(request(), network_delegate(), mime_type,
+                                      charset, data, status_code, headers);
+  real_job_->Start();
+}
+
 void AdapterRequestJob::CreateFileJobAndStart(const base::FilePath& path) {
   DCHECK(content::BrowserThread::CurrentlyOn(content::BrowserThread::IO));
 
@@ -98,6 +120,17 @@ void AdapterRequestJob::CreateFileJobAndStart(const base::FilePath& path) {
   real_job_->Start();
 }
 
+void AdapterRequestJob::CreateStreamJobAndStart(
+    const std::string& mime_type,
+    const std::string& charset,
+    base::WeakPtr<URLRequestStreamJob::Source> source) {
+  DCHECK(content::BrowserThread::CurrentlyOn(content::BrowserThread::IO));
+
+  real_job_ = new URLRequestStreamJob(
+      request(), network_delegate(), mime_type, charset, source);
+  real_job_->Start();
+}
+
 void AdapterRequestJob::CreateJobFromProtocolHandlerAndStart() {
   DCHECK(content::BrowserThread::CurrentlyOn(content::BrowserThread::IO));
   DCHECK(protocol_handler_);
@@ -7,6 +7,8 @@
 
 #include <string>
 
+#include "atom/browser/net/url_request_buffer_job.h"
+#include "atom/browser/net/url_request_stream_job.h"
 #include "base/memory/weak_ptr.h"
 #include "net/url_request/url_request_job.h"
 #include "net/url_request/url_request_job_factory.h"
@@ -38,6 +40,8 @@ class AdapterRequestJob : public net::URLRequestJob {
   virtual net::Filter* SetupFilter() const OVERRIDE;
   virtual bool GetMimeType(std::string* mime_type) const OVERRIDE;
   virtual bool GetCharset(std::string* charset) OVERRIDE;
+  virtual void GetResponseInfo(net::HttpResponseInfo* info) OVERRIDE;
+  virtual int GetResponseCode() const OVERRIDE;
 
   base::WeakPtr<AdapterRequestJob> GetWeakPtr();
 
@@ -50,7 +54,17 @@ class AdapterRequestJob : public net::URLRequestJob {
   void CreateStringJobAndStart(const std::string& mime_type,
                                const std::string& charset,
                                const std::string& data);
+  void CreateBufferJobAndStart(
+      const std::string& mime_type,
+      const std::string& charset,
+      scoped_refptr<base::RefCountedMemory> data,
+      int status_code,
+      const URLRequestBufferJob::HeadersMap& headers);
   void CreateFileJobAndStart(const base::FilePath& path);
+  void CreateStreamJobAndStart(
+      const std::string& mime_type,
+      const std::string& charset,
+      base::WeakPtr<URLRequestStreamJob::Source> source);
   void CreateJobFromProtocolHandlerAndStart();
 
  private:
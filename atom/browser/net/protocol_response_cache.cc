@@ -0,0 +1,103 @@
+// Copyright (c) 2014 GitHub, Inc. All rights reserved.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/net/protocol_response_cache.h"
+
+#include "content/public/browser/browser_thread.h"
+#include "url/gurl.h"
+
+using content::BrowserThread;
+
+namespace atom {
+
+namespace {
+
+// The ref of URL is never sent to the protocol handler.
+std::string GetCacheKey(const GURL& url) {
+  GURL::Replacements replacements;
+  replacements.ClearRef();
+  return url.ReplaceComponents(replacements).spec();
+}
+
+size_t GetEntrySize(const ProtocolResponseCache::Entry& entry) {
+  return entry.data ? entry.data->size() : 0;
+}
+
+}  // namespace
+
+ProtocolResponseCache::Entry::Entry() {
+}
+
+ProtocolResponseCache::Entry::~Entry() {
+}
+
+ProtocolResponseCache::ProtocolResponseCache()
+    : entries_(EntryMap::NO_AUTO_EVICT),
+      capacity_(0),
+      size_(0),
+      generation_(0) {
+}
+
+ProtocolResponseCache::~ProtocolResponseCache() {
+}
+
+void ProtocolResponseCache::SetCapacity(size_t capacity) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  capacity_ = capacity;
+  EvictFor(0);
+}
+
+void ProtocolResponseCache::Put(const GURL& url,
+                                int generation,
+                                const Entry& entry) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  size_t entry_size = GetEntrySize(entry);
+  if (generation != generation_ || entry_size > capacity_)
+    return;
+
+  std::string key = GetCacheKey(url);
+  EntryMap::iterator it = entries_.Peek(key);
+  if (it != entries_.end()) {
+    size_ -= GetEntrySize(it->second);
+    entries_.Erase(it);
+  }
+
+  EvictFor(entry_size);
+  entries_.Put(key, entry);
+  size_ += entry_size;
+}
+
+const ProtocolResponseCache::Entry* ProtocolResponseCache::Get(
+    const GURL& url) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  EntryMap::iterator it = entries_.Get(GetCacheKey(url));
+  return it == entries_.end() ? NULL : &it->second;
+}
+
+void ProtocolResponseCache::Remove(const GURL& url) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  ++generation_;
+  EntryMap::iterator it = entries_.Peek(GetCacheKey(url));
+  if (it != entries_.end()) {
+    size_ -= GetEntrySize(it->second);
+    entries_.Erase(it);
+  }
+}
+
+void ProtocolResponseCache::Clear() {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  ++generation_;
+  entries_.Clear();
+  size_ = 0;
+}
+
+void ProtocolResponseCache::EvictFor(size_t size) {
+  while (!entries_.empty() && size_ + size > capacity_) {
+    EntryMap::reverse_iterator oldest = entries_.rbegin();
+    size_ -= GetEntrySize(oldest->second);
+    entries_.Erase(oldest);
+  }
+}
+
+}  // namespace atom
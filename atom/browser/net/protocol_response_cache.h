@@ -0,0 +1,81 @@
+// Copyright (c) 2014 GitHub, Inc. All rights reserved.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_NET_PROTOCOL_RESPONSE_CACHE_H_
+#define ATOM_BROWSER_NET_PROTOCOL_RESPONSE_CACHE_H_
+
+#include <string>
+
+#include "atom/browser/net/url_request_buffer_job.h"
+#include "base/containers/mru_cache.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/ref_counted_memory.h"
+
+class GURL;
+
+namespace atom {
+
+// Keeps the responses of a custom protocol in memory, so requests for the
+// same URL can be answered in IO thread without asking the JS handler.
+//
+// The cache is bounded by the total size of the cached data, and the least
+// recently used responses are evicted first. It is created in IO thread but
+// referenced by jobs whose handlers run in UI thread, all of its methods must
+// be called in IO thread.
+class ProtocolResponseCache
+    : public base::RefCountedThreadSafe<ProtocolResponseCache> {
+ public:
+  struct Entry {
+    Entry();
+    ~Entry();
+
+    std::string mime_type;
+    std::string charset;
+    scoped_refptr<base::RefCountedMemory> data;
+    URLRequestBufferJob::HeadersMap headers;
+  };
+
+  ProtocolResponseCache();
+
+  // Sets the maximum size of cached data in bytes, 0 disables the cache.
+  void SetCapacity(size_t capacity);
+
+  // Stores the response of |url|. The response is dropped if the cache has
+  // been invalidated after |generation| was taken, since it may be stale.
+  void Put(const GURL& url, int generation, const Entry& entry);
+
+  // Returns the cached response of |url| and marks it as recently used, or
+  // NULL when it is not cached.
+  const Entry* Get(const GURL& url);
+
+  void Remove(const GURL& url);
+  void Clear();
+
+  bool enabled() const { return capacity_ > 0; }
+  size_t capacity() const { return capacity_; }
+  int generation() const { return generation_; }
+
+ private:
+  friend class base::RefCountedThreadSafe<ProtocolResponseCache>;
+
+  typedef base::MRUCache<std::string, Entry> EntryMap;
+
+  ~ProtocolResponseCache();
+
+  // Evicts the least recently used entries until |size| more bytes fit.
+  void EvictFor(size_t size);
+
+  EntryMap entries_;
+  size_t capacity_;
+  size_t size_;
+
+  // Bumped on every invalidation.
+  int generation_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProtocolResponseCache);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_NET_PROTOCOL_RESPONSE_CACHE_H_
@@ -0,0 +1,112 @@
+// Copyright (c) 2014 GitHub, Inc. All rights reserved.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/net/url_request_buffer_job.h"
+
+#include <string>
+
+#include "base/strings/stringprintf.h"
+#include "net/base/net_errors.h"
+#include "net/http/http_byte_range.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_response_info.h"
+#include "net/http/http_util.h"
+
+namespace atom {
+
+URLRequestBufferJob::URLRequestBufferJob(
+    net::URLRequest* request,
+    net::NetworkDelegate* network_delegate,
+    const std::string& mime_type,
+    const std::string& charset,
+    scoped_refptr<base::RefCountedMemory> data,
+    int status_code,
+    const HeadersMap& headers)
+    : net::URLRequestSimpleJob(request, network_delegate),
+      mime_type_(mime_type),
+      charset_(charset),
+      data_(data),
+      status_code_(status_code),
+      headers_(headers) {
+}
+
+URLRequestBufferJob::~URLRequestBufferJob() {
+}
+
+int URLRequestBufferJob::GetRefCountedData(
+    std::string* mime_type,
+    std::string* charset,
+    scoped_refptr<base::RefCountedMemory>* data,
+    const net::CompletionCallback& callback) const {
+  *mime_type = mime_type_;
+  *charset = charset_;
+  *data = data_;
+  return net::OK;
+}
+
+void URLRequestBufferJob::SetExtraRequestHeaders(
+    const net::HttpRequestHeaders& headers) {
+  // URLRequestSimpleJob slices the data to the requested range whatever the
+  // status code is, so only let it see the Range header of 200 responses.
+  if (status_code_ == 200)
+    net::URLRequestSimpleJob::SetExtraRequestHeaders(headers);
+}
+
+void URLRequestBufferJob::GetResponseInfo(net::HttpResponseInfo* info) {
+  info->headers = GetResponseHeaders();
+}
+
+int URLRequestBufferJob::GetResponseCode() const {
+  return GetResponseHeaders()->response_code();
+}
+
+net::HttpResponseHeaders* URLRequestBufferJob::GetResponseHeaders() const {
+  if (response_headers_)
+    return response_headers_.get();
+
+  // URLRequestSimpleJob only sends the requested range of the data, so tell
+  // the requester which part it is getting.
+  int status_code = status_code_;
+  int64 size = data_ ? data_->size() : 0;
+  net::HttpByteRange range;
+  bool partial = false;
+  if (status_code == 200 && ranges().size() == 1) {
+    range = ranges()[0];
+    partial = range.ComputeBounds(size);
+    if (partial)
+      status_code = 206;
+  }
+
+  std::string status = base::StringPrintf("HTTP/1.1 %d\n", status_code);
+  response_headers_ = new net::HttpResponseHeaders(
+      net::HttpUtil::AssembleRawHeaders(status.c_str(), status.size()));
+  for (HeadersMap::const_iterator it = headers_.begin();
+       it != headers_.end(); ++it)
+    response_headers_->AddHeader(it->first + ": " + it->second);
+
+  if (!response_headers_->HasHeader("Content-Type")) {
+    std::string content_type = mime_type_;
+    if (!charset_.empty())
+      content_type += "; charset=" + charset_;
+    response_headers_->AddHeader("Content-Type: " + content_type);
+  }
+
+  if (!response_headers_->HasHeader("Accept-Ranges"))
+    response_headers_->AddHeader("Accept-Ranges: bytes");
+  if (partial) {
+    // The headers passed in describe the whole data.
+    response_headers_->RemoveHeader("Content-Range");
+    response_headers_->RemoveHeader("Content-Length");
+    response_headers_->AddHeader(base::StringPrintf(
+        "Content-Range: bytes %" PRId64 "-%" PRId64 "/%" PRId64,
+        range.first_byte_position(), range.last_byte_position(), size));
+    response_headers_->AddHeader(base::StringPrintf(
+        "Content-Length: %" PRId64,
+        range.last_byte_position() - range.first_byte_position() + 1));
+  }
+
+  return response_headers_.get();
+}
+
+}  // namespace atom
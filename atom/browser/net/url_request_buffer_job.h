@@ -0,0 +1,71 @@
+// Copyright (c) 2014 GitHub, Inc. All rights reserved.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_NET_URL_REQUEST_BUFFER_JOB_H_
+#define ATOM_BROWSER_NET_URL_REQUEST_BUFFER_JOB_H_
+
+#include <map>
+#include <string>
+
+#include "base/memory/ref_counted_memory.h"
+#include "net/url_request/url_request_simple_job.h"
+
+namespace net {
+class HttpRequestHeaders;
+class HttpResponseHeaders;
+}
+
+namespace atom {
+
+// Sends a buffer as response without copying it, so the same buffer can be
+// shared by all requests.
+//
+// The response has the status code and headers passed in, and a request for
+// a single byte range of a 200 response is answered with 206 and the
+// Content-Range header. The Range header is ignored for other status codes.
+class URLRequestBufferJob : public net::URLRequestSimpleJob {
+ public:
+  typedef std::map<std::string, std::string> HeadersMap;
+
+  URLRequestBufferJob(net::URLRequest* request,
+                      net::NetworkDelegate* network_delegate,
+                      const std::string& mime_type,
+                      const std::string& charset,
+                      scoped_refptr<base::RefCountedMemory> data,
+                      int status_code,
+                      const HeadersMap& headers);
+
+  // URLRequestSimpleJob:
+  virtual int GetRefCountedData(
+      std::string* mime_type,
+      std::string* charset,
+      scoped_refptr<base::RefCountedMemory>* data,
+      const net::CompletionCallback& callback) const OVERRIDE;
+  virtual void SetExtraRequestHeaders(
+      const net::HttpRequestHeaders& headers) OVERRIDE;
+  virtual void GetResponseInfo(net::HttpResponseInfo* info) OVERRIDE;
+  virtual int GetResponseCode() const OVERRIDE;
+
+ protected:
+  virtual ~URLRequestBufferJob();
+
+ private:
+  // Builds the response headers when they are first needed, the Range header
+  // of the request has been parsed by then.
+  net::HttpResponseHeaders* GetResponseHeaders() const;
+
+  std::string mime_type_;
+  std::string charset_;
+  scoped_refptr<base::RefCountedMemory> data_;
+  int status_code_;
+  HeadersMap headers_;
+
+  mutable scoped_refptr<net::HttpResponseHeaders> response_headers_;
+
+  DISALLOW_COPY_AND_ASSIGN(URLRequestBufferJob);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_NET_URL_REQUEST_BUFFER_JOB_H_
@@ -0,0 +1,159 @@
+// Copyright (c) 2014 GitHub, Inc. All rights reserved.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/net/url_request_stream_job.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "base/bind.h"
+#include "base/message_loop/message_loop.h"
+#include "content/public/browser/browser_thread.h"
+#include "net/base/net_errors.h"
+#include "net/url_request/url_request_status.h"
+
+using content::BrowserThread;
+
+namespace atom {
+
+URLRequestStreamJob::URLRequestStreamJob(
+    net::URLRequest* request,
+    net::NetworkDelegate* network_delegate,
+    const std::string& mime_type,
+    const std::string& charset,
+    base::WeakPtr<Source> source)
+    : net::URLRequestJob(request, network_delegate),
+      mime_type_(mime_type),
+      charset_(charset),
+      source_(source),
+      chunk_offset_(0),
+      pending_buf_size_(0),
+      ended_(false),
+      error_(net::OK),
+      weak_factory_(this) {
+}
+
+URLRequestStreamJob::~URLRequestStreamJob() {
+}
+
+void URLRequestStreamJob::AppendData(
+    scoped_refptr<base::RefCountedString> data) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  if (ended_ || data->size() == 0)
+    return;
+
+  chunks_.push_back(data);
+  if (!pending_buf_)
+    return;
+
+  int bytes_read = CopyData(pending_buf_.get(), pending_buf_size_);
+  pending_buf_ = NULL;
+  SetStatus(net::URLRequestStatus());
+  NotifyReadComplete(bytes_read);
+}
+
+void URLRequestStreamJob::End(int error) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  if (ended_)
+    return;
+
+  ended_ = true;
+  error_ = error;
+  if (!pending_buf_)
+    return;
+
+  pending_buf_ = NULL;
+  if (error_ == net::OK) {
+    SetStatus(net::URLRequestStatus());
+    NotifyReadComplete(0);
+  } else {
+    NotifyDone(net::URLRequestStatus(net::URLRequestStatus::FAILED, error_));
+  }
+}
+
+void URLRequestStreamJob::Start() {
+  // Start reading asynchronously so that all error reporting and data
+  // callbacks happen as they would for network requests.
+  base::MessageLoop::current()->PostTask(
+      FROM_HERE,
+      base::Bind(&URLRequestStreamJob::StartAsync,
+                 weak_factory_.GetWeakPtr()));
+}
+
+void URLRequestStreamJob::Kill() {
+  weak_factory_.InvalidateWeakPtrs();
+  BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
+      base::Bind(&Source::OnJobKilled, source_));
+  net::URLRequestJob::Kill();
+}
+
+bool URLRequestStreamJob::ReadRawData(net::IOBuffer* buf,
+                                      int buf_size,
+                                      int* bytes_read) {
+  DCHECK(!pending_buf_);
+
+  if (!chunks_.empty()) {
+    *bytes_read = CopyData(buf, buf_size);
+    return true;
+  }
+
+  if (ended_) {
+    if (error_ != net::OK) {
+      NotifyDone(net::URLRequestStatus(net::URLRequestStatus::FAILED, error_));
+      return false;
+    }
+    *bytes_read = 0;
+    return true;
+  }
+
+  // Wait for more data.
+  pending_buf_ = buf;
+  pending_buf_size_ = buf_size;
+  SetStatus(net::URLRequestStatus(net::URLRequestStatus::IO_PENDING, 0));
+  return false;
+}
+
+bool URLRequestStreamJob::GetMimeType(std::string* mime_type) const {
+  *mime_type = mime_type_;
+  return true;
+}
+
+bool URLRequestStreamJob::GetCharset(std::string* charset) {
+  *charset = charset_;
+  return true;
+}
+
+void URLRequestStreamJob::StartAsync() {
+  BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
+      base::Bind(&Source::OnJobStarted, source_, weak_factory_.GetWeakPtr()));
+  NotifyHeadersComplete();
+}
+
+int URLRequestStreamJob::CopyData(net::IOBuffer* buf, int buf_size) {
+  int copied = 0;
+  while (copied < buf_size && !chunks_.empty()) {
+    const std::string& chunk = chunks_.front()->data();
+    size_t size = std::min(chunk.size() - chunk_offset_,
+                           static_cast<size_t>(buf_size - copied));
+    memcpy(buf->data() + copied, chunk.data() + chunk_offset_, size);
+    copied += size;
+    chunk_offset_ += size;
+    if (chunk_offset_ == chunk.size()) {
+      chunks_.pop_front();
+      chunk_offset_ = 0;
+    }
+  }
+
+  NotifyDataConsumed(copied);
+  return copied;
+}
+
+void URLRequestStreamJob::NotifyDataConsumed(int bytes) {
+  if (bytes > 0)
+    BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
+        base::Bind(&Source::OnDataConsumed, source_, bytes));
+}
+
+}  // namespace atom
@@ -0,0 +1,94 @@
+// Copyright (c) 2014 GitHub, Inc. All rights reserved.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_NET_URL_REQUEST_STREAM_JOB_H_
+#define ATOM_BROWSER_NET_URL_REQUEST_STREAM_JOB_H_
+
+#include <deque>
+#include <string>
+
+#include "base/memory/ref_counted.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/memory/weak_ptr.h"
+#include "net/base/io_buffer.h"
+#include "net/url_request/url_request_job.h"
+
+namespace atom {
+
+// Sends the response body as it is fed in chunks from the UI thread, instead
+// of having the whole body in memory.
+class URLRequestStreamJob : public net::URLRequestJob {
+ public:
+  // Feeds the job on the UI thread.
+  class Source {
+   public:
+    // Called when the job has started and can receive data.
+    virtual void OnJobStarted(base::WeakPtr<URLRequestStreamJob> job) = 0;
+
+    // Called when |bytes| of the fed data have been read by the request, the
+    // source should stop feeding when it has fed too much unread data.
+    virtual void OnDataConsumed(int bytes) = 0;
+
+    // Called when the request is cancelled.
+    virtual void OnJobKilled() = 0;
+
+   protected:
+    virtual ~Source() {}
+  };
+
+  URLRequestStreamJob(net::URLRequest* request,
+                      net::NetworkDelegate* network_delegate,
+                      const std::string& mime_type,
+                      const std::string& charset,
+                      base::WeakPtr<Source> source);
+
+  // Appends a chunk of the body.
+  void AppendData(scoped_refptr<base::RefCountedString> data);
+
+  // Ends the body, |error| is net::OK when the body is complete.
+  void End(int error);
+
+  // net::URLRequestJob:
+  virtual void Start() OVERRIDE;
+  virtual void Kill() OVERRIDE;
+  virtual bool ReadRawData(net::IOBuffer* buf,
+                           int buf_size,
+                           int* bytes_read) OVERRIDE;
+  virtual bool GetMimeType(std::string* mime_type) const OVERRIDE;
+  virtual bool GetCharset(std::string* charset) OVERRIDE;
+
+ private:
+  virtual ~URLRequestStreamJob();
+
+  void StartAsync();
+
+  // Copies the buffered data into |buf|, returns the number of bytes copied.
+  int CopyData(net::IOBuffer* buf, int buf_size);
+
+  // Tells the source how much data has been read.
+  void NotifyDataConsumed(int bytes);
+
+  std::string mime_type_;
+  std::string charset_;
+  base::WeakPtr<Source> source_;
+
+  // The fed chunks and the read position in the first one.
+  std::deque<scoped_refptr<base::RefCountedString> > chunks_;
+  size_t chunk_offset_;
+
+  // The pending read waiting for data.
+  scoped_refptr<net::IOBuffer> pending_buf_;
+  int pending_buf_size_;
+
+  bool ended_;
+  int error_;
+
+  base::WeakPtrFactory<URLRequestStreamJob> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(URLRequestStreamJob);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_NET_URL_REQUEST_STREAM_JOB_H_
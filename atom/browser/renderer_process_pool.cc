@@ -0,0 +1,134 @@
+// Copyright (c) 2014 GitHub, Inc. All rights reserved.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/renderer_process_pool.h"
+
+#include "atom/browser/atom_browser_context.h"
+#include "base/bind.h"
+#include "base/message_loop/message_loop.h"
+#include "base/metrics/histogram.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/site_instance.h"
+
+namespace atom {
+
+// static
+RendererProcessPool* RendererProcessPool::instance_ = NULL;
+
+// static
+RendererProcessPool* RendererProcessPool::GetInstance() {
+  if (!instance_)
+    instance_ = new RendererProcessPool;
+  return instance_;
+}
+
+RendererProcessPool::RendererProcessPool()
+    : size_(0),
+      hits_(0),
+      misses_(0),
+      refill_posted_(false) {
+}
+
+RendererProcessPool::~RendererProcessPool() {
+}
+
+void RendererProcessPool::SetSize(size_t size) {
+  size_ = size;
+  Refill();
+}
+
+scoped_refptr<content::SiteInstance> RendererProcessPool::Take() {
+  if (size_ == 0)
+    return NULL;
+
+  scoped_refptr<content::SiteInstance> instance;
+  while (!spares_.empty() && !instance) {
+    instance = spares_.front();
+    spares_.pop_front();
+
+    // Skip the processes that have crashed while waiting.
+    if (!instance->GetProcess()->HasConnection())
+      instance = NULL;
+  }
+
+  UMA_HISTOGRAM_BOOLEAN("AtomShell.RendererProcessPool.Hit", instance != NULL);
+  if (instance) {
+    ++hits_;
+    content::RenderProcessHost* process = instance->GetProcess();
+    if (taken_processes_.insert(process->GetID()).second)
+      process->AddObserver(this);
+  } else {
+    ++misses_;
+  }
+
+  // Launch the replacement after the window has started its navigation.
+  PostRefill();
+  return instance;
+}
+
+bool RendererProcessPool::ClaimTakenProcess(
+    content::RenderProcessHost* process) {
+  if (taken_processes_.erase(process->GetID()) == 0)
+    return false;
+
+  process->RemoveObserver(this);
+  return true;
+}
+
+void RendererProcessPool::Shutdown() {
+  SetSize(0);
+
+  for (std::set<int>::const_iterator iter = taken_processes_.begin();
+       iter != taken_processes_.end(); ++iter) {
+    content::RenderProcessHost* process =
+        content::RenderProcessHost::FromID(*iter);
+    if (process)
+      process->RemoveObserver(this);
+  }
+  taken_processes_.clear();
+}
+
+std::vector<int> RendererProcessPool::GetSpareProcessIds() const {
+  std::vector<int> ids;
+  for (size_t i = 0; i < spares_.size(); ++i)
+    ids.push_back(spares_[i]->GetProcess()->GetID());
+  return ids;
+}
+
+void RendererProcessPool::RenderProcessHostDestroyed(
+    content::RenderProcessHost* host) {
+  // The window that took the process was closed before navigating.
+  taken_processes_.erase(host->GetID());
+  host->RemoveObserver(this);
+}
+
+void RendererProcessPool::Refill() {
+  refill_posted_ = false;
+
+  while (spares_.size() > size_) {
+    content::RenderProcessHost* process = spares_.back()->GetProcess();
+    spares_.pop_back();
+    process->Cleanup();
+  }
+
+  while (spares_.size() < size_) {
+    scoped_refptr<content::SiteInstance> instance =
+        content::SiteInstance::Create(AtomBrowserContext::Get());
+    if (!instance->GetProcess()->Init())
+      break;
+    spares_.push_back(instance);
+  }
+}
+
+void RendererProcessPool::PostRefill() {
+  if (refill_posted_)
+    return;
+
+  refill_posted_ = true;
+  base::MessageLoop::current()->PostTask(
+      FROM_HERE,
+      base::Bind(&RendererProcessPool::Refill, base::Unretained(this)));
+}
+
+}  // namespace atom
@@ -0,0 +1,89 @@
+// Copyright (c) 2014 GitHub, Inc. All rights reserved.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_RENDERER_PROCESS_POOL_H_
+#define ATOM_BROWSER_RENDERER_PROCESS_POOL_H_
+
+#include <deque>
+#include <set>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/memory/ref_counted.h"
+#include "content/public/browser/render_process_host_observer.h"
+
+namespace content {
+class RenderProcessHost;
+class SiteInstance;
+}
+
+namespace atom {
+
+// Keeps a number of renderer processes launched before they are needed, so
+// new windows don't have to wait for the renderer process to start and for
+// node to be initialized in it.
+//
+// The spare processes are launched without a window, so they get the default
+// switches and can only be used by windows with the default
+// "node-integration" and "zoom-factor" options.
+class RendererProcessPool : public content::RenderProcessHostObserver {
+ public:
+  static RendererProcessPool* GetInstance();
+
+  // Changes the number of spare processes to keep, the pool is empty by
+  // default.
+  void SetSize(size_t size);
+  size_t size() const { return size_; }
+
+  // Returns a SiteInstance whose renderer process has been launched, or NULL
+  // when there is no spare process.
+  scoped_refptr<content::SiteInstance> Take();
+
+  // Returns true if |process| was returned by Take() and has not been used
+  // for navigation yet, the process is forgotten after this call.
+  bool ClaimTakenProcess(content::RenderProcessHost* process);
+
+  // Releases all the spare processes and stops refilling, called before the
+  // browser context is destroyed.
+  void Shutdown();
+
+  // Returns the IDs of the spare processes, in the order they would be taken.
+  std::vector<int> GetSpareProcessIds() const;
+
+  size_t spare_count() const { return spares_.size(); }
+  int hits() const { return hits_; }
+  int misses() const { return misses_; }
+
+ private:
+  RendererProcessPool();
+  virtual ~RendererProcessPool();
+
+  // content::RenderProcessHostObserver:
+  virtual void RenderProcessHostDestroyed(
+      content::RenderProcessHost* host) OVERRIDE;
+
+  // Launches or releases processes until there are |size_| spare ones.
+  void Refill();
+  void PostRefill();
+
+  size_t size_;
+  std::deque<scoped_refptr<content::SiteInstance>> spares_;
+
+  // The IDs of processes that have been taken but not navigated, they are
+  // observed so the IDs are forgotten when the windows never navigate.
+  std::set<int> taken_processes_;
+
+  int hits_;
+  int misses_;
+
+  bool refill_posted_;
+
+  static RendererProcessPool* instance_;
+
+  DISALLOW_COPY_AND_ASSIGN(RendererProcessPool);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_RENDERER_PROCESS_POOL_H_
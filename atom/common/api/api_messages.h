@@ -4,6 +4,8 @@
 
 // Multiply-included file, no traditional include guard.
 
+#include <string>
+
 #include "atom/common/draggable_region.h"
 #include "base/strings/string16.h"
 #include "base/values.h"
@@ -33,6 +35,22 @@ IPC_MESSAGE_ROUTED2(AtomViewMsg_Message,
                     base::string16 /* channel */,
                     base::ListValue /* arguments */)
 
+// Like AtomViewHostMsg_Message and AtomViewMsg_Message, but the arguments are
+// serialized by atom::V8ValueSerializer instead of being converted into
+// base::ListValue.
+IPC_MESSAGE_ROUTED2(AtomViewHostMsg_Message_Serialized,
+                    base::string16 /* channel */,
+                    std::string /* serialized arguments */)
+
+IPC_MESSAGE_ROUTED2(AtomViewMsg_Message_Serialized,
+                    base::string16 /* channel */,
+                    std::string /* serialized arguments */)
+
+IPC_SYNC_MESSAGE_ROUTED2_1(AtomViewHostMsg_Message_Sync_Serialized,
+                           base::string16 /* channel */,
+                           std::string /* serialized arguments */,
+                           std::string /* serialized result */)
+
 // Sent by the renderer when the draggable regions are updated.
 IPC_MESSAGE_ROUTED1(AtomViewHostMsg_UpdateDraggableRegions,
                     std::vector<atom::DraggableRegion> /* regions */)
@@ -0,0 +1,103 @@
+// Copyright (c) 2014 GitHub, Inc. All rights reserved.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/api/atom_api_archive.h"
+
+#include <string>
+#include <vector>
+
+#include "atom/common/native_mate_converters/file_path_converter.h"
+#include "native_mate/dictionary.h"
+#include "native_mate/object_template_builder.h"
+
+#include "atom/common/node_includes.h"
+
+namespace atom {
+
+namespace api {
+
+Archive::Archive(scoped_ptr<atom::Archive> archive)
+    : archive_(archive.Pass()) {
+}
+
+Archive::~Archive() {
+}
+
+base::FilePath Archive::GetPath() const {
+  return archive_->path();
+}
+
+v8::Handle<v8::Value> Archive::Stat(v8::Isolate* isolate,
+                                    const base::FilePath& path) {
+  atom::Archive::Stats stats;
+  if (!archive_->Stat(path, &stats))
+    return v8::False(isolate);
+
+  mate::Dictionary dict(isolate);
+  dict.Set("size", stats.size);
+  dict.Set("offset", stats.offset);
+  dict.Set("isFile", stats.is_file);
+  dict.Set("isDirectory", stats.is_directory);
+  return mate::ConvertToV8(isolate, dict);
+}
+
+v8::Handle<v8::Value> Archive::Readdir(v8::Isolate* isolate,
+                                       const base::FilePath& path) {
+  std::vector<std::string> names;
+  if (!archive_->Readdir(path, &names))
+    return v8::False(isolate);
+  return mate::ConvertToV8(isolate, names);
+}
+
+v8::Handle<v8::Value> Archive::ReadFile(v8::Isolate* isolate,
+                                        const base::FilePath& path) {
+  atom::Archive::FileInfo info;
+  if (!archive_->GetFileInfo(path, &info))
+    return v8::False(isolate);
+  return node::Buffer::New(archive_->GetFileData(info), info.size);
+}
+
+mate::ObjectTemplateBuilder Archive::GetObjectTemplateBuilder(
+    v8::Isolate* isolate) {
+  return mate::ObjectTemplateBuilder(isolate)
+      .SetMethod("getPath", &Archive::GetPath)
+      .SetMethod("stat", &Archive::Stat)
+      .SetMethod("readdir", &Archive::Readdir)
+      .SetMethod("readFile", &Archive::ReadFile);
+}
+
+// static
+mate::Handle<Archive> Archive::Create(v8::Isolate* isolate,
+                                      const base::FilePath& path) {
+  scoped_ptr<atom::Archive> archive(new atom::Archive(path));
+  if (!archive->Init())
+    return mate::Handle<Archive>();
+  return mate::CreateHandle(isolate, new Archive(archive.Pass()));
+}
+
+}  // namespace api
+
+}  // namespace atom
+
+
+namespace {
+
+v8::Handle<v8::Value> CreateArchive(v8::Isolate* isolate,
+                                    const base::FilePath& path) {
+  mate::Handle<atom::api::Archive> archive =
+      atom::api::Archive::Create(isolate, path);
+  if (archive.IsEmpty())
+    return v8::False(isolate);
+  return archive.ToV8();
+}
+
+void Initialize(v8::Handle<v8::Object> exports, v8::Handle<v8::Value> unused,
+                v8::Handle<v8::Context> context, void* priv) {
+  mate::Dictionary dict(context->GetIsolate(), exports);
+  dict.SetMethod("createArchive", &CreateArchive);
+}
+
+}  // namespace
+
+NODE_MODULE_CONTEXT_AWARE_BUILTIN(atom_common_archive, Initialize)
@@ -0,0 +1,47 @@
+// Copyright (c) 2014 GitHub, Inc. All rights reserved.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_API_ATOM_API_ARCHIVE_H_
+#define ATOM_COMMON_API_ATOM_API_ARCHIVE_H_
+
+#include "atom/common/archive.h"
+#include "native_mate/handle.h"
+#include "native_mate/wrappable.h"
+
+namespace atom {
+
+namespace api {
+
+class Archive : public mate::Wrappable {
+ public:
+  // Returns an empty handle when |path| is not a valid archive.
+  static mate::Handle<Archive> Create(v8::Isolate* isolate,
+                                      const base::FilePath& path);
+
+ protected:
+  explicit Archive(scoped_ptr<atom::Archive> archive);
+  virtual ~Archive();
+
+  // mate::Wrappable implementations:
+  virtual mate::ObjectTemplateBuilder GetObjectTemplateBuilder(
+      v8::Isolate* isolate) OVERRIDE;
+
+ private:
+  base::FilePath GetPath() const;
+  v8::Handle<v8::Value> Stat(v8::Isolate* isolate, const base::FilePath& path);
+  v8::Handle<v8::Value> Readdir(v8::Isolate* isolate,
+                                const base::FilePath& path);
+  v8::Handle<v8::Value> ReadFile(v8::Isolate* isolate,
+                                 const base::FilePath& path);
+
+  scoped_ptr<atom::Archive> archive_;
+
+  DISALLOW_COPY_AND_ASSIGN(Archive);
+};
+
+}  // namespace api
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_API_ATOM_API_ARCHIVE_H_
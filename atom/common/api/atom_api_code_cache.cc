@@ -0,0 +1,94 @@
+// Copyright (c) 2014 GitHub, Inc. All rights reserved.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include <string.h>
+
+#include <string>
+
+#include "base/hash.h"
+#include "native_mate/dictionary.h"
+
+#include "atom/common/node_includes.h"
+
+namespace {
+
+// The cache starts with the hash of the code it is created from, so a stale
+// cache would never be used for changed code.
+typedef uint32 CacheHeader;
+
+CacheHeader HashCode(v8::Handle<v8::String> code) {
+  v8::String::Utf8Value utf8(code);
+  return base::Hash(*utf8, utf8.length());
+}
+
+v8::Local<v8::Script> CompileScript(v8::Isolate* isolate,
+                                    v8::Handle<v8::String> code,
+                                    v8::Handle<v8::String> filename,
+                                    v8::ScriptCompiler::CachedData* cache,
+                                    v8::ScriptCompiler::CompileOptions options,
+                                    std::string* produced_cache) {
+  v8::ScriptOrigin origin(filename);
+  v8::ScriptCompiler::Source source(code, origin, cache);
+  v8::Local<v8::Script> script =
+      v8::ScriptCompiler::Compile(isolate, &source, options);
+
+  const v8::ScriptCompiler::CachedData* data = source.GetCachedData();
+  if (produced_cache && data)
+    produced_cache->append(reinterpret_cast<const char*>(data->data),
+                           data->length);
+  return script;
+}
+
+// Compiles |code| without running it, and returns the data V8 can use to
+// compile the same code faster next time.
+v8::Handle<v8::Value> CreateCache(v8::Isolate* isolate,
+                                  v8::Handle<v8::String> code,
+                                  v8::Handle<v8::String> filename) {
+  CacheHeader header = HashCode(code);
+  std::string cache(reinterpret_cast<const char*>(&header), sizeof(header));
+  v8::Local<v8::Script> script = CompileScript(
+      isolate, code, filename, NULL,
+      v8::ScriptCompiler::kProduceDataToCache, &cache);
+  if (script.IsEmpty())  // Compilation error, the exception is pending.
+    return v8::Undefined(isolate);
+  return node::Buffer::New(cache.data(), cache.size());
+}
+
+// Compiles |code| with the data from CreateCache() and runs it, the data is
+// ignored when it was not created from |code|.
+v8::Handle<v8::Value> RunScript(v8::Isolate* isolate,
+                                v8::Handle<v8::String> code,
+                                v8::Handle<v8::String> filename,
+                                v8::Handle<v8::Value> cache) {
+  v8::ScriptCompiler::CachedData* cached_data = NULL;
+  if (node::Buffer::HasInstance(cache) &&
+      node::Buffer::Length(cache) > sizeof(CacheHeader)) {
+    const char* data = node::Buffer::Data(cache);
+    CacheHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (header == HashCode(code))
+      cached_data = new v8::ScriptCompiler::CachedData(
+          reinterpret_cast<const uint8_t*>(data + sizeof(header)),
+          node::Buffer::Length(cache) - sizeof(header));
+  }
+
+  // V8 uses the cached data when it is available in the source.
+  v8::Local<v8::Script> script = CompileScript(
+      isolate, code, filename, cached_data,
+      v8::ScriptCompiler::kNoCompileOptions, NULL);
+  if (script.IsEmpty())
+    return v8::Undefined(isolate);
+  return script->Run();
+}
+
+void Initialize(v8::Handle<v8::Object> exports, v8::Handle<v8::Value> unused,
+                v8::Handle<v8::Context> context, void* priv) {
+  mate::Dictionary dict(context->GetIsolate(), exports);
+  dict.SetMethod("createCache", &CreateCache);
+  dict.SetMethod("runScript", &RunScript);
+}
+
+}  // namespace
+
+NODE_MODULE_CONTEXT_AWARE_BUILTIN(atom_common_code_cache, Initialize)
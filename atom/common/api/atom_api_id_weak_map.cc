@@ -4,8 +4,6 @@
 
 #include "atom/common/api/atom_api_id_weak_map.h"
 
-#include <algorithm>
-
 #include "base/logging.h"
 #include "native_mate/constructor.h"
 #include "native_mate/object_template_builder.h"
@@ -16,55 +14,49 @@ namespace atom {
 
 namespace api {
 
-IDWeakMap::IDWeakMap()
-    : next_id_(0) {
+IDWeakMap::IDWeakMap() {
 }
 
 IDWeakMap::~IDWeakMap() {
 }
 
 int32_t IDWeakMap::Add(v8::Isolate* isolate, v8::Handle<v8::Object> object) {
-  int32_t key = GetNextID();
-  object->SetHiddenValue(mate::StringToV8(isolate, "IDWeakMapKey"),
-                         mate::Converter<int32_t>::ToV8(isolate, key));
+  linked_ptr<Entry> entry(new Entry);
+  entry->map = this;
+  entry->key = map_.Add(entry);
+  if (entry->key == SlotMap<linked_ptr<Entry> >::kInvalidID) {
+    node::ThrowError("Too many objects in IDWeakMap");
+    return entry->key;
+  }
 
-  map_[key] = new mate::RefCountedPersistent<v8::Object>(isolate, object);
-  map_[key]->SetWeak(this, WeakCallback);
-  return key;
+  entry->handle.reset(isolate, object);
+  entry->handle.SetWeak(entry.get(), WeakCallback);
+  return entry->key;
 }
 
 v8::Handle<v8::Value> IDWeakMap::Get(v8::Isolate* isolate, int32_t key) {
-  if (!Has(key)) {
+  linked_ptr<Entry>* entry = map_.Get(key);
+  if (!entry) {
     node::ThrowError("Invalid key");
     return v8::Undefined(isolate);
   }
 
-  return map_[key]->NewHandle();
+  return (*entry)->handle.NewHandle();
 }
 
 bool IDWeakMap::Has(int32_t key) const {
-  return map_.find(key) != map_.end();
+  return map_.Has(key);
 }
 
 std::vector<int32_t> IDWeakMap::Keys() const {
-  std::vector<int32_t> keys;
-  keys.reserve(map_.size());
-  for (auto it = map_.begin(); it != map_.end(); ++it)
-    keys.push_back(it->first);
-  return keys;
+  return map_.Keys();
 }
 
 void IDWeakMap::Remove(int32_t key) {
-  if (Has(key))
-    map_.erase(key);
-  else
+  if (!map_.Remove(key))
     LOG(WARNING) << "Object with key " << key << " is being GCed for twice.";
 }
 
-int IDWeakMap::GetNextID() {
-  return ++next_id_;
-}
-
 // static
 void IDWeakMap::BuildPrototype(v8::Isolate* isolate,
                                v8::Handle<v8::ObjectTemplate> prototype) {
@@ -78,10 +70,9 @@ void IDWeakMap::BuildPrototype(v8::Isolate* isolate,
 
 // static
 void IDWeakMap::WeakCallback(
-    const v8::WeakCallbackData<v8::Object, IDWeakMap>& data) {
-  int32_t key = data.GetValue()->GetHiddenValue(
-      mate::StringToV8(data.GetIsolate(), "IDWeakMapKey"))->Int32Value();
-  data.GetParameter()->Remove(key);
+    const v8::WeakCallbackData<v8::Object, Entry>& data) {
+  Entry* entry = data.GetParameter();
+  entry->map->Remove(entry->key);
 }
 
 }  // namespace api
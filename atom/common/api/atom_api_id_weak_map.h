@@ -6,10 +6,11 @@
 #ifndef ATOM_COMMON_API_ATOM_API_ID_WEAK_MAP_H_
 #define ATOM_COMMON_API_ATOM_API_ID_WEAK_MAP_H_
 
-#include <map>
 #include <vector>
 
+#include "atom/common/slot_map.h"
 #include "base/basictypes.h"
+#include "base/memory/linked_ptr.h"
 #include "native_mate/scoped_persistent.h"
 #include "native_mate/wrappable.h"
 
@@ -33,16 +34,21 @@ class IDWeakMap : public mate::Wrappable {
   bool Has(int32_t key) const;
   std::vector<int32_t> Keys() const;
   void Remove(int32_t key);
-  int GetNextID();
 
-  static void WeakCallback(
-      const v8::WeakCallbackData<v8::Object, IDWeakMap>& data);
+  // The weak handle of an object, it is also the parameter of weak callback
+  // so we know which key to remove when the object is GCed.
+  struct Entry {
+    IDWeakMap* map;
+    int32_t key;
+    mate::ScopedPersistent<v8::Object> handle;
+  };
 
-  int32_t next_id_;
+  static void WeakCallback(
+      const v8::WeakCallbackData<v8::Object, Entry>& data);
 
-  typedef scoped_refptr<mate::RefCountedPersistent<v8::Object> >
-      RefCountedV8Object;
-  std::map<int32_t, RefCountedV8Object> map_;
+  // Entries are allocated separately so their addresses stay the same when
+  // the slots grow.
+  SlotMap<linked_ptr<Entry> > map_;
 
   DISALLOW_COPY_AND_ASSIGN(IDWeakMap);
 };
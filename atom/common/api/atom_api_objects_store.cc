@@ -0,0 +1,85 @@
+// Copyright (c) 2014 GitHub, Inc. All rights reserved.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/api/atom_api_objects_store.h"
+
+#include "native_mate/constructor.h"
+#include "native_mate/object_template_builder.h"
+
+#include "atom/common/node_includes.h"
+
+namespace atom {
+
+namespace api {
+
+ObjectsStore::ObjectsStore() {
+}
+
+ObjectsStore::~ObjectsStore() {
+}
+
+int32_t ObjectsStore::Add(v8::Isolate* isolate,
+                          v8::Handle<v8::Object> object) {
+  int32_t id = objects_.Add(
+      new mate::RefCountedPersistent<v8::Object>(isolate, object));
+  if (id == SlotMap<RefCountedV8Object>::kInvalidID)
+    node::ThrowError("Too many objects in ObjectsStore");
+  return id;
+}
+
+v8::Handle<v8::Value> ObjectsStore::Get(v8::Isolate* isolate, int32_t id) {
+  RefCountedV8Object* object = objects_.Get(id);
+  if (!object) {
+    node::ThrowError("Invalid key for ObjectsStore");
+    return v8::Undefined(isolate);
+  }
+
+  return (*object)->NewHandle();
+}
+
+bool ObjectsStore::Has(int32_t id) const {
+  return objects_.Has(id);
+}
+
+void ObjectsStore::Remove(int32_t id) {
+  if (!objects_.Remove(id))
+    node::ThrowError("Invalid key for ObjectsStore");
+}
+
+int ObjectsStore::Size() const {
+  return static_cast<int>(objects_.size());
+}
+
+// static
+void ObjectsStore::BuildPrototype(v8::Isolate* isolate,
+                                  v8::Handle<v8::ObjectTemplate> prototype) {
+  mate::ObjectTemplateBuilder(isolate, prototype)
+      .SetMethod("add", &ObjectsStore::Add)
+      .SetMethod("get", &ObjectsStore::Get)
+      .SetMethod("has", &ObjectsStore::Has)
+      .SetMethod("remove", &ObjectsStore::Remove)
+      .SetMethod("getSize", &ObjectsStore::Size);
+}
+
+}  // namespace api
+
+}  // namespace atom
+
+
+namespace {
+
+void Initialize(v8::Handle<v8::Object> exports, v8::Handle<v8::Value> unused,
+                v8::Handle<v8::Context> context, void* priv) {
+  using atom::api::ObjectsStore;
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::Local<v8::Function> constructor = mate::CreateConstructor<ObjectsStore>(
+      isolate,
+      "ObjectsStore",
+      base::Bind(&mate::NewOperatorFactory<ObjectsStore>));
+  exports->Set(mate::StringToV8(isolate, "ObjectsStore"), constructor);
+}
+
+}  // namespace
+
+NODE_MODULE_CONTEXT_AWARE_BUILTIN(atom_common_objects_store, Initialize)
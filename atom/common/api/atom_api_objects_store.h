@@ -0,0 +1,45 @@
+// Copyright (c) 2014 GitHub, Inc. All rights reserved.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_API_ATOM_API_OBJECTS_STORE_H_
+#define ATOM_COMMON_API_ATOM_API_OBJECTS_STORE_H_
+
+#include "atom/common/slot_map.h"
+#include "native_mate/scoped_persistent.h"
+#include "native_mate/wrappable.h"
+
+namespace atom {
+
+namespace api {
+
+// Keeps strong references to objects and gives each of them an integer ID,
+// unlike IDWeakMap the objects stay alive until they are removed.
+class ObjectsStore : public mate::Wrappable {
+ public:
+  ObjectsStore();
+
+  static void BuildPrototype(v8::Isolate* isolate,
+                             v8::Handle<v8::ObjectTemplate> prototype);
+
+ private:
+  virtual ~ObjectsStore();
+
+  int32_t Add(v8::Isolate* isolate, v8::Handle<v8::Object> object);
+  v8::Handle<v8::Value> Get(v8::Isolate* isolate, int32_t id);
+  bool Has(int32_t id) const;
+  void Remove(int32_t id);
+  int Size() const;
+
+  typedef scoped_refptr<mate::RefCountedPersistent<v8::Object> >
+      RefCountedV8Object;
+  SlotMap<RefCountedV8Object> objects_;
+
+  DISALLOW_COPY_AND_ASSIGN(ObjectsStore);
+};
+
+}  // namespace api
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_API_ATOM_API_OBJECTS_STORE_H_
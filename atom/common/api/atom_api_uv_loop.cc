@@ -0,0 +1,87 @@
+// Copyright (c) 2014 GitHub, Inc. All rights reserved.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/node_bindings.h"
+#include "base/float_util.h"
+#include "base/metrics/histogram_base.h"
+#include "base/metrics/histogram_samples.h"
+#include "native_mate/dictionary.h"
+
+#include "atom/common/node_includes.h"
+
+namespace {
+
+v8::Handle<v8::Value> GetStats(v8::Isolate* isolate) {
+  const atom::NodeBindings::UvLoopStats& stats =
+      atom::NodeBindings::Get()->uv_loop_stats();
+  mate::Dictionary dict(isolate);
+  dict.Set("runs", static_cast<double>(stats.runs));
+  dict.Set("iterations", static_cast<double>(stats.iterations));
+  dict.Set("budgetExhausted", static_cast<double>(stats.budget_exhausted));
+  return mate::ConvertToV8(isolate, dict);
+}
+
+v8::Handle<v8::Value> HistogramToV8(v8::Isolate* isolate,
+                                    base::HistogramBase* histogram) {
+  scoped_ptr<base::HistogramSamples> samples = histogram->SnapshotSamples();
+
+  v8::Local<v8::Array> buckets = v8::Array::New(isolate);
+  int index = 0;
+  for (scoped_ptr<base::SampleCountIterator> it = samples->Iterator();
+       !it->Done(); it->Next()) {
+    base::HistogramBase::Sample min, max;
+    base::HistogramBase::Count count;
+    it->Get(&min, &max, &count);
+    mate::Dictionary bucket(isolate);
+    bucket.Set("min", min);
+    bucket.Set("max", max);
+    bucket.Set("count", count);
+    buckets->Set(index++, mate::ConvertToV8(isolate, bucket));
+  }
+
+  mate::Dictionary dict(isolate);
+  dict.Set("count", samples->TotalCount());
+  dict.Set("sum", static_cast<double>(samples->sum()));
+  dict.Set("buckets", buckets);
+  return mate::ConvertToV8(isolate, dict);
+}
+
+// Returns the histograms of uv loop, durations are in microseconds.
+v8::Handle<v8::Value> GetHistograms(v8::Isolate* isolate) {
+  typedef atom::NodeBindings NodeBindings;
+  NodeBindings* bindings = NodeBindings::Get();
+  mate::Dictionary dict(isolate);
+  dict.Set("wakeupLatency", HistogramToV8(
+      isolate, bindings->uv_loop_histogram(NodeBindings::WAKEUP_LATENCY)));
+  dict.Set("runDuration", HistogramToV8(
+      isolate, bindings->uv_loop_histogram(NodeBindings::RUN_DURATION)));
+  dict.Set("iterationsPerRun", HistogramToV8(
+      isolate, bindings->uv_loop_histogram(NodeBindings::ITERATIONS_PER_RUN)));
+  return mate::ConvertToV8(isolate, dict);
+}
+
+double GetDrainBudget() {
+  return atom::NodeBindings::Get()->drain_budget().InMillisecondsF();
+}
+
+void SetDrainBudget(double milliseconds) {
+  if (!base::IsFinite(milliseconds) || milliseconds < 0)
+    return node::ThrowTypeError("Drain budget should be a non-negative number");
+
+  atom::NodeBindings::Get()->set_drain_budget(
+      base::TimeDelta::FromMicroseconds(milliseconds * 1000));
+}
+
+void Initialize(v8::Handle<v8::Object> exports, v8::Handle<v8::Value> unused,
+                v8::Handle<v8::Context> context, void* priv) {
+  mate::Dictionary dict(context->GetIsolate(), exports);
+  dict.SetMethod("getStats", &GetStats);
+  dict.SetMethod("getHistograms", &GetHistograms);
+  dict.SetMethod("getDrainBudget", &GetDrainBudget);
+  dict.SetMethod("setDrainBudget", &SetDrainBudget);
+}
+
+}  // namespace
+
+NODE_MODULE_CONTEXT_AWARE_BUILTIN(atom_common_uv_loop, Initialize)
@@ -0,0 +1,136 @@
+// Copyright (c) 2014 GitHub, Inc. All rights reserved.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/archive.h"
+
+#include <string.h>
+
+#include "base/json/json_reader.h"
+#include "base/logging.h"
+#include "base/values.h"
+
+namespace atom {
+
+namespace {
+
+const char kFiles[] = "files";
+const char kOffset[] = "offset";
+const char kSize[] = "size";
+
+bool GetChildNode(const base::DictionaryValue* dir,
+                  const std::string& name,
+                  const base::DictionaryValue** out) {
+  const base::DictionaryValue* files;
+  return dir->GetDictionaryWithoutPathExpansion(kFiles, &files) &&
+         files->GetDictionaryWithoutPathExpansion(name, out);
+}
+
+}  // namespace
+
+Archive::Archive(const base::FilePath& path)
+    : path_(path),
+      header_size_(0) {
+}
+
+Archive::~Archive() {
+}
+
+bool Archive::Init() {
+  if (!file_.Initialize(path_)) {
+    LOG(ERROR) << "Failed to map archive: " << path_.value();
+    return false;
+  }
+
+  if (file_.length() < sizeof(header_size_))
+    return false;
+  memcpy(&header_size_, file_.data(), sizeof(header_size_));
+  if (file_.length() - sizeof(header_size_) < header_size_)
+    return false;
+
+  std::string header(
+      reinterpret_cast<const char*>(file_.data()) + sizeof(header_size_),
+      header_size_);
+  scoped_ptr<base::Value> value(base::JSONReader::Read(header));
+  if (!value || !value->IsType(base::Value::TYPE_DICTIONARY)) {
+    LOG(ERROR) << "Failed to parse header of archive: " << path_.value();
+    return false;
+  }
+
+  header_.reset(static_cast<base::DictionaryValue*>(value.release()));
+  return true;
+}
+
+bool Archive::GetFileInfo(const base::FilePath& path, FileInfo* info) const {
+  const base::DictionaryValue* node = GetNode(path);
+  if (!node)
+    return false;
+
+  int offset, size;
+  if (!node->GetInteger(kOffset, &offset) || !node->GetInteger(kSize, &size))
+    return false;
+
+  // Never give out a range outside the mapped file.
+  size_t data_size = file_.length() - sizeof(header_size_) - header_size_;
+  if (offset < 0 || size < 0 ||
+      static_cast<size_t>(offset) > data_size ||
+      static_cast<size_t>(size) > data_size - offset)
+    return false;
+
+  info->offset = offset;
+  info->size = size;
+  return true;
+}
+
+bool Archive::Stat(const base::FilePath& path, Stats* stats) const {
+  const base::DictionaryValue* node = GetNode(path);
+  if (!node)
+    return false;
+
+  if (node->HasKey(kFiles)) {
+    stats->is_file = false;
+    stats->is_directory = true;
+    return true;
+  }
+
+  return GetFileInfo(path, stats);
+}
+
+bool Archive::Readdir(const base::FilePath& path,
+                      std::vector<std::string>* names) const {
+  const base::DictionaryValue* node = GetNode(path);
+  const base::DictionaryValue* files;
+  if (!node || !node->GetDictionaryWithoutPathExpansion(kFiles, &files))
+    return false;
+
+  for (base::DictionaryValue::Iterator it(*files); !it.IsAtEnd(); it.Advance())
+    names->push_back(it.key());
+  return true;
+}
+
+const char* Archive::GetFileData(const FileInfo& info) const {
+  return reinterpret_cast<const char*>(file_.data()) +
+         sizeof(header_size_) + header_size_ + info.offset;
+}
+
+const base::DictionaryValue* Archive::GetNode(
+    const base::FilePath& path) const {
+  if (!header_)
+    return NULL;
+
+  std::vector<base::FilePath::StringType> components;
+  path.GetComponents(&components);
+
+  const base::DictionaryValue* node = header_.get();
+  for (size_t i = 0; i < components.size(); ++i) {
+    if (components[i].empty() ||
+        components[i] == base::FilePath::kCurrentDirectory)
+      continue;
+    std::string name = base::FilePath(components[i]).AsUTF8Unsafe();
+    if (!GetChildNode(node, name, &node))
+      return NULL;
+  }
+  return node;
+}
+
+}  // namespace atom
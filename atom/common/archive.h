@@ -0,0 +1,80 @@
+// Copyright (c) 2014 GitHub, Inc. All rights reserved.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_ARCHIVE_H_
+#define ATOM_COMMON_ARCHIVE_H_
+
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/memory/scoped_ptr.h"
+
+namespace base {
+class DictionaryValue;
+}
+
+namespace atom {
+
+// Reads files from an archive created by script/create-archive.py, the
+// archive is mapped into memory once and the files are read from the mapping.
+//
+// The archive starts with a 32-bit little-endian size of the header, followed
+// by the header which is a JSON tree of directories and files, and then the
+// content of all files. A directory is {"files": {name: node}}, and a file is
+// {"offset": offset, "size": size}, where offset is counted from the end of the
+// header.
+class Archive {
+ public:
+  struct FileInfo {
+    FileInfo() : size(0), offset(0) {}
+    uint32 size;
+    uint32 offset;
+  };
+
+  struct Stats : public FileInfo {
+    Stats() : is_file(true), is_directory(false) {}
+    bool is_file;
+    bool is_directory;
+  };
+
+  explicit Archive(const base::FilePath& path);
+  ~Archive();
+
+  // Maps the archive and reads its header, returns false when the file can not
+  // be mapped or is not an archive.
+  bool Init();
+
+  // Gets the info of a file, |path| is relative to the root of the archive.
+  bool GetFileInfo(const base::FilePath& path, FileInfo* info) const;
+
+  // Gets the info of a file or a directory.
+  bool Stat(const base::FilePath& path, Stats* stats) const;
+
+  // Lists the names of the entries in a directory.
+  bool Readdir(const base::FilePath& path,
+               std::vector<std::string>* names) const;
+
+  // Returns the content of the file, which points into the mapped archive and
+  // is valid as long as the archive.
+  const char* GetFileData(const FileInfo& info) const;
+
+  base::FilePath path() const { return path_; }
+
+ private:
+  // Finds the node of |path| in the header.
+  const base::DictionaryValue* GetNode(const base::FilePath& path) const;
+
+  base::FilePath path_;
+  base::MemoryMappedFile file_;
+  uint32 header_size_;
+  scoped_ptr<base::DictionaryValue> header_;
+
+  DISALLOW_COPY_AND_ASSIGN(Archive);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_ARCHIVE_H_
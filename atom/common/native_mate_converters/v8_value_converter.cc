@@ -11,6 +11,8 @@
 #include "base/memory/scoped_ptr.h"
 #include "base/values.h"
 
+#include "atom/common/node_includes.h"
+
 namespace atom {
 
 V8ValueConverter::V8ValueConverter()
@@ -91,6 +93,12 @@ v8::Local<v8::Value> V8ValueConverter::ToV8ValueImpl(
       return ToV8Object(isolate,
                         static_cast<const base::DictionaryValue*>(value));
 
+    case base::Value::TYPE_BINARY: {
+      const base::BinaryValue* binary =
+          static_cast<const base::BinaryValue*>(value);
+      return node::Buffer::New(binary->GetBuffer(), binary->GetSize());
+    }
+
     default:
       LOG(ERROR) << "Unexpected value type: " << value->GetType();
       return v8::Null(isolate);
@@ -193,6 +201,12 @@ base::Value* V8ValueConverter::FromV8ValueImpl(v8::Local<v8::Value> val,
     return FromV8Object(val->ToObject(), unique_map);
   }
 
+  // Keep the content of node::Buffer as binary data, so it becomes a Buffer
+  // again when converted back, like V8ValueSerializer does.
+  if (node::Buffer::HasInstance(val))
+    return base::BinaryValue::CreateWithCopiedBuffer(
+        node::Buffer::Data(val), node::Buffer::Length(val));
+
   if (val->IsObject()) {
     return FromV8Object(val->ToObject(), unique_map);
   }
@@ -0,0 +1,438 @@
+// Copyright (c) 2014 GitHub, Inc. All rights reserved.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/native_mate_converters/v8_value_serializer.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "base/float_util.h"
+#include "base/logging.h"
+#include "base/pickle.h"
+
+#include "atom/common/node_includes.h"
+
+namespace atom {
+
+namespace {
+
+// Tags that prefix every serialized value.
+enum Tag {
+  TAG_NULL = 0,
+  TAG_TRUE,
+  TAG_FALSE,
+  TAG_INT32,
+  TAG_DOUBLE,
+  TAG_STRING,
+  TAG_ARRAY,
+  TAG_OBJECT,
+  TAG_PROPERTY,
+  TAG_END,
+  TAG_BUFFER,
+};
+
+// JSON.stringify skips these values in objects and puts null in arrays.
+bool IsSkippedValue(v8::Handle<v8::Value> value) {
+  return value->IsUndefined() || value->IsFunction();
+}
+
+void WriteString(v8::Handle<v8::Value> value, Pickle* pickle) {
+  v8::String::Utf8Value utf8(value->ToString());
+  pickle->WriteData(*utf8, utf8.length());
+}
+
+bool ReadString(v8::Isolate* isolate,
+                PickleIterator* iter,
+                v8::Local<v8::String>* out) {
+  const char* data;
+  int length;
+  if (!iter->ReadData(&data, &length))
+    return false;
+  *out = v8::String::NewFromUtf8(
+      isolate, data, v8::String::kNormalString, length);
+  return true;
+}
+
+}  // namespace
+
+V8ValueSerializer::V8ValueSerializer() : json_compatible_(false) {
+}
+
+void V8ValueSerializer::SetJSONCompatible(bool val) {
+  json_compatible_ = val;
+}
+
+bool V8ValueSerializer::Serialize(v8::Handle<v8::Value> value,
+                                  std::string* data) const {
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::HandleScope handle_scope(isolate);
+  if (json_compatible_ && !CallToJSON(v8::String::Empty(isolate), &value))
+    return false;
+
+  HashToHandleMap unique_map;
+  Pickle pickle;
+  if (IsSkippedValue(value))
+    pickle.WriteInt(TAG_NULL);
+  else if (!WriteValue(value, &pickle, &unique_map))
+    return false;
+
+  data->assign(static_cast<const char*>(pickle.data()), pickle.size());
+  return true;
+}
+
+bool V8ValueSerializer::SerializeBatch(v8::Handle<v8::Array> messages,
+                                       std::string* data) const {
+  v8::HandleScope handle_scope(v8::Isolate::GetCurrent());
+  Pickle pickle;
+  pickle.WriteInt(TAG_ARRAY);
+  pickle.WriteInt(TAG_ARRAY);
+  for (uint32 i = 0; i < messages->Length(); ++i) {
+    v8::TryCatch try_catch;
+    v8::Local<v8::Value> message = messages->Get(i);
+    if (try_catch.HasCaught())
+      return false;
+
+    // Objects are only deduplicated inside one message.
+    HashToHandleMap unique_map;
+    if (IsSkippedValue(message))
+      pickle.WriteInt(TAG_NULL);
+    else if (!WriteValue(message, &pickle, &unique_map))
+      return false;
+  }
+  pickle.WriteInt(TAG_END);
+  pickle.WriteInt(TAG_END);
+
+  data->assign(static_cast<const char*>(pickle.data()), pickle.size());
+  return true;
+}
+
+v8::Handle<v8::Value> V8ValueSerializer::Deserialize(
+    v8::Isolate* isolate, const std::string& data) const {
+  Pickle pickle(data.data(), data.size());
+  PickleIterator iter(pickle);
+  v8::Handle<v8::Value> value;
+  if (!ReadValue(isolate, &iter, &value))
+    return v8::Handle<v8::Value>();
+  return value;
+}
+
+bool V8ValueSerializer::DeserializeArray(
+    v8::Isolate* isolate,
+    const std::string& data,
+    std::vector<v8::Handle<v8::Value>>* values) const {
+  Pickle pickle(data.data(), data.size());
+  PickleIterator iter(pickle);
+  int tag;
+  if (!iter.ReadInt(&tag) || tag != TAG_ARRAY)
+    return false;
+
+  while (true) {
+    v8::Handle<v8::Value> value;
+    if (!ReadValue(isolate, &iter, &value))
+      return false;
+    if (value.IsEmpty())  // TAG_END
+      return true;
+    values->push_back(value);
+  }
+}
+
+bool V8ValueSerializer::CallToJSON(v8::Handle<v8::Value> key,
+                                   v8::Handle<v8::Value>* value) const {
+  // Buffers have a toJSON method too, but they are sent as raw bytes.
+  if (!(*value)->IsObject() || node::Buffer::HasInstance(*value))
+    return true;
+
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::Handle<v8::Object> object = (*value)->ToObject();
+  v8::TryCatch try_catch;
+  v8::Local<v8::Value> to_json =
+      object->Get(v8::String::NewFromUtf8(isolate, "toJSON"));
+  if (try_catch.HasCaught())
+    return false;
+  if (!to_json->IsFunction())
+    return true;
+
+  v8::Handle<v8::Value> argv[] = { key };
+  v8::Local<v8::Value> result =
+      to_json.As<v8::Function>()->Call(object, arraysize(argv), argv);
+  if (try_catch.HasCaught())
+    return false;
+
+  *value = result;
+  return true;
+}
+
+bool V8ValueSerializer::WriteValue(v8::Handle<v8::Value> val,
+                                   Pickle* pickle,
+                                   HashToHandleMap* unique_map) const {
+  CHECK(!val.IsEmpty());
+
+  if (val->IsNull())
+    return pickle->WriteInt(TAG_NULL);
+
+  if (val->IsBoolean())
+    return pickle->WriteInt(val->IsTrue() ? TAG_TRUE : TAG_FALSE);
+
+  if (val->IsInt32())
+    return pickle->WriteInt(TAG_INT32) &&
+           pickle->WriteInt(val->ToInt32()->Value());
+
+  if (val->IsNumber()) {
+    double number = val->ToNumber()->Value();
+    if (json_compatible_ && !base::IsFinite(number))
+      return pickle->WriteInt(TAG_NULL);
+    return pickle->WriteInt(TAG_DOUBLE) &&
+           pickle->WriteBytes(&number, sizeof(number));
+  }
+
+  if (val->IsString()) {
+    pickle->WriteInt(TAG_STRING);
+    WriteString(val, pickle);
+    return true;
+  }
+
+  // v8::Value doesn't have a ToArray() method for some reason.
+  if (val->IsArray())
+    return WriteArray(val.As<v8::Array>(), pickle, unique_map);
+
+  // Copy the content of node::Buffer in one piece, instead of flattening it
+  // into an object with a property for every byte.
+  if (node::Buffer::HasInstance(val))
+    return pickle->WriteInt(TAG_BUFFER) &&
+           pickle->WriteData(node::Buffer::Data(val),
+                             node::Buffer::Length(val));
+
+  // Dates and regexps are converted to objects, like V8ValueConverter does
+  // when they are not explicitly allowed.
+  if (val->IsObject() && !val->IsFunction())
+    return WriteObject(val->ToObject(), pickle, unique_map);
+
+  return false;
+}
+
+bool V8ValueSerializer::WriteArray(v8::Handle<v8::Array> val,
+                                   Pickle* pickle,
+                                   HashToHandleMap* unique_map) const {
+  if (!UpdateAndCheckUniqueness(unique_map, val)) {
+    // JSON.stringify throws on cyclic structures.
+    if (json_compatible_)
+      return false;
+    return pickle->WriteInt(TAG_NULL);
+  }
+
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  pickle->WriteInt(TAG_ARRAY);
+  for (uint32 i = 0; i < val->Length(); ++i) {
+    v8::TryCatch try_catch;
+    v8::Local<v8::Value> child = val->Get(i);
+    if (try_catch.HasCaught())
+      return false;
+
+    if (!val->HasRealIndexedProperty(i))
+      continue;
+
+    if (json_compatible_ &&
+        !CallToJSON(v8::Integer::NewFromUnsigned(isolate, i)->ToString(),
+                    &child))
+      return false;
+
+    if (IsSkippedValue(child))
+      pickle->WriteInt(TAG_NULL);
+    else if (!WriteValue(child, pickle, unique_map))
+      return false;
+  }
+
+  if (json_compatible_)
+    RemoveFromUniqueMap(unique_map, val);
+  return pickle->WriteInt(TAG_END);
+}
+
+bool V8ValueSerializer::WriteObject(v8::Handle<v8::Object> val,
+                                    Pickle* pickle,
+                                    HashToHandleMap* unique_map) const {
+  if (!UpdateAndCheckUniqueness(unique_map, val)) {
+    // JSON.stringify throws on cyclic structures.
+    if (json_compatible_)
+      return false;
+    return pickle->WriteInt(TAG_NULL);
+  }
+
+  pickle->WriteInt(TAG_OBJECT);
+  v8::Local<v8::Array> property_names(val->GetOwnPropertyNames());
+  for (uint32 i = 0; i < property_names->Length(); ++i) {
+    v8::Local<v8::Value> key(property_names->Get(i));
+    if (!key->IsString() && !key->IsNumber())
+      return false;
+
+    // Skip all callbacks: crbug.com/139933
+    if (val->HasRealNamedCallbackProperty(key->ToString()))
+      continue;
+
+    v8::TryCatch try_catch;
+    v8::Local<v8::Value> child = val->Get(key);
+    if (try_catch.HasCaught())
+      return false;
+
+    if (json_compatible_ && !CallToJSON(key, &child))
+      return false;
+
+    if (IsSkippedValue(child))
+      continue;
+
+    pickle->WriteInt(TAG_PROPERTY);
+    WriteString(key, pickle);
+    if (!WriteValue(child, pickle, unique_map))
+      return false;
+  }
+
+  if (json_compatible_)
+    RemoveFromUniqueMap(unique_map, val);
+  return pickle->WriteInt(TAG_END);
+}
+
+bool V8ValueSerializer::ReadValue(v8::Isolate* isolate,
+                                  PickleIterator* iter,
+                                  v8::Handle<v8::Value>* value) const {
+  int tag;
+  if (!iter->ReadInt(&tag))
+    return false;
+
+  switch (tag) {
+    case TAG_NULL:
+      *value = v8::Null(isolate);
+      return true;
+
+    case TAG_TRUE:
+    case TAG_FALSE:
+      *value = v8::Boolean::New(isolate, tag == TAG_TRUE);
+      return true;
+
+    case TAG_INT32: {
+      int val;
+      if (!iter->ReadInt(&val))
+        return false;
+      *value = v8::Integer::New(isolate, val);
+      return true;
+    }
+
+    case TAG_DOUBLE: {
+      const char* data;
+      double val;
+      if (!iter->ReadBytes(&data, sizeof(val)))
+        return false;
+      memcpy(&val, data, sizeof(val));
+      *value = v8::Number::New(isolate, val);
+      return true;
+    }
+
+    case TAG_STRING: {
+      v8::Local<v8::String> val;
+      if (!ReadString(isolate, iter, &val))
+        return false;
+      *value = val;
+      return true;
+    }
+
+    case TAG_BUFFER: {
+      const char* data;
+      int length;
+      if (!iter->ReadData(&data, &length))
+        return false;
+      *value = node::Buffer::New(data, length);
+      return true;
+    }
+
+    case TAG_ARRAY:
+      return ReadArray(isolate, iter, value);
+
+    case TAG_OBJECT:
+      return ReadObject(isolate, iter, value);
+
+    case TAG_END:
+      // Leave |value| empty to tell the caller the container has ended.
+      *value = v8::Handle<v8::Value>();
+      return true;
+
+    default:
+      LOG(ERROR) << "Unexpected tag in serialized value: " << tag;
+      return false;
+  }
+}
+
+bool V8ValueSerializer::ReadArray(v8::Isolate* isolate,
+                                  PickleIterator* iter,
+                                  v8::Handle<v8::Value>* value) const {
+  v8::Local<v8::Array> result(v8::Array::New(isolate));
+  for (uint32 i = 0; ; ++i) {
+    v8::Handle<v8::Value> child;
+    if (!ReadValue(isolate, iter, &child))
+      return false;
+    if (child.IsEmpty())
+      break;
+    result->Set(i, child);
+  }
+
+  *value = result;
+  return true;
+}
+
+bool V8ValueSerializer::ReadObject(v8::Isolate* isolate,
+                                   PickleIterator* iter,
+                                   v8::Handle<v8::Value>* value) const {
+  v8::Local<v8::Object> result(v8::Object::New(isolate));
+  while (true) {
+    int tag;
+    if (!iter->ReadInt(&tag))
+      return false;
+    if (tag == TAG_END)
+      break;
+    if (tag != TAG_PROPERTY)
+      return false;
+
+    v8::Local<v8::String> key;
+    v8::Handle<v8::Value> child;
+    if (!ReadString(isolate, iter, &key) ||
+        !ReadValue(isolate, iter, &child) ||
+        child.IsEmpty())
+      return false;
+    result->Set(key, child);
+  }
+
+  *value = result;
+  return true;
+}
+
+bool V8ValueSerializer::UpdateAndCheckUniqueness(
+    HashToHandleMap* map,
+    v8::Handle<v8::Object> handle) const {
+  typedef HashToHandleMap::const_iterator Iterator;
+
+  int hash = handle->GetIdentityHash();
+  std::pair<Iterator, Iterator> range = map->equal_range(hash);
+  for (Iterator it = range.first; it != range.second; ++it) {
+    if (it->second == handle)
+      return false;
+  }
+
+  map->insert(std::pair<int, v8::Handle<v8::Object> >(hash, handle));
+  return true;
+}
+
+void V8ValueSerializer::RemoveFromUniqueMap(
+    HashToHandleMap* map,
+    v8::Handle<v8::Object> handle) const {
+  typedef HashToHandleMap::iterator Iterator;
+
+  std::pair<Iterator, Iterator> range =
+      map->equal_range(handle->GetIdentityHash());
+  for (Iterator it = range.first; it != range.second; ++it) {
+    if (it->second == handle) {
+      map->erase(it);
+      return;
+    }
+  }
+}
+
+}  // namespace atom
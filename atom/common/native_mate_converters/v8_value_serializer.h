@@ -0,0 +1,107 @@
+// Copyright (c) 2014 GitHub, Inc. All rights reserved.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_NATIVE_MATE_CONVERTERS_V8_VALUE_SERIALIZER_H_
+#define ATOM_COMMON_NATIVE_MATE_CONVERTERS_V8_VALUE_SERIALIZER_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "v8/include/v8.h"
+
+class Pickle;
+class PickleIterator;
+
+namespace atom {
+
+// Serializes V8 values into a compact binary buffer and back, without building
+// the intermediate base::Value tree that V8ValueConverter needs.
+//
+// The conversion rules are the same with V8ValueConverter's defaults: dates
+// and regexps become plain objects, functions and undefined are skipped in
+// objects and become null in arrays, and objects that appear more than once
+// are serialized as null. The only exception is node::Buffer, which is copied
+// as raw bytes and recreated as a Buffer on the other side.
+//
+// With SetJSONCompatible(true) the rules follow JSON.stringify instead, which
+// is what synchronous replies used to go through.
+class V8ValueSerializer {
+ public:
+  V8ValueSerializer();
+
+  // If true, toJSON methods are called (so dates become strings), objects that
+  // appear more than once are kept unless they contain themselves, in which
+  // case serializing fails, and non-finite numbers become null. Buffers are
+  // still sent as raw bytes.
+  void SetJSONCompatible(bool val);
+
+  // Serializes |value| into |data|. Returns false when |value| contains
+  // something that can not be serialized, in which case callers should fall
+  // back to V8ValueConverter.
+  bool Serialize(v8::Handle<v8::Value> value, std::string* data) const;
+
+  // Serializes |messages| as the arguments of a batch message, i.e. into the
+  // same data as Serialize([messages]). Each message is serialized on its own,
+  // so an object that appears in several messages is kept in all of them.
+  bool SerializeBatch(v8::Handle<v8::Array> messages, std::string* data) const;
+
+  // Deserializes |data| created by Serialize(), returns an empty handle when
+  // |data| is malformed.
+  v8::Handle<v8::Value> Deserialize(v8::Isolate* isolate,
+                                    const std::string& data) const;
+
+  // Deserializes |data| which must contain a serialized array, and appends its
+  // elements to |values| without creating the array itself.
+  bool DeserializeArray(v8::Isolate* isolate,
+                        const std::string& data,
+                        std::vector<v8::Handle<v8::Value>>* values) const;
+
+ private:
+  typedef std::multimap<int, v8::Handle<v8::Object> > HashToHandleMap;
+
+  // Replaces |value| with the result of its toJSON method when it has one,
+  // |key| is passed to the method like JSON.stringify does. Returns false if
+  // the method throws.
+  bool CallToJSON(v8::Handle<v8::Value> key,
+                  v8::Handle<v8::Value>* value) const;
+
+  bool WriteValue(v8::Handle<v8::Value> value,
+                  Pickle* pickle,
+                  HashToHandleMap* unique_map) const;
+  bool WriteArray(v8::Handle<v8::Array> array,
+                  Pickle* pickle,
+                  HashToHandleMap* unique_map) const;
+  bool WriteObject(v8::Handle<v8::Object> object,
+                   Pickle* pickle,
+                   HashToHandleMap* unique_map) const;
+
+  bool ReadValue(v8::Isolate* isolate,
+                 PickleIterator* iter,
+                 v8::Handle<v8::Value>* value) const;
+  bool ReadArray(v8::Isolate* isolate,
+                 PickleIterator* iter,
+                 v8::Handle<v8::Value>* value) const;
+  bool ReadObject(v8::Isolate* isolate,
+                  PickleIterator* iter,
+                  v8::Handle<v8::Value>* value) const;
+
+  // Same with V8ValueConverter::UpdateAndCheckUniqueness.
+  bool UpdateAndCheckUniqueness(HashToHandleMap* map,
+                                v8::Handle<v8::Object> handle) const;
+
+  // Removes |handle| from |map| once its children have been written, so in
+  // JSON compatible mode only the ancestors of a value are checked.
+  void RemoveFromUniqueMap(HashToHandleMap* map,
+                           v8::Handle<v8::Object> handle) const;
+
+  bool json_compatible_;
+
+  DISALLOW_COPY_AND_ASSIGN(V8ValueSerializer);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_NATIVE_MATE_CONVERTERS_V8_VALUE_SERIALIZER_H_
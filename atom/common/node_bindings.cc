@@ -9,8 +9,10 @@
 
 #include "base/command_line.h"
 #include "base/base_paths.h"
+#include "base/debug/trace_event.h"
 #include "base/files/file_path.h"
 #include "base/message_loop/message_loop.h"
+#include "base/metrics/histogram.h"
 #include "base/path_service.h"
 #include "content/public/browser/browser_thread.h"
 #include "native_mate/locker.h"
@@ -69,11 +71,15 @@ REFERENCE_MODULE(atom_browser_protocol);
 REFERENCE_MODULE(atom_browser_global_shortcut);
 REFERENCE_MODULE(atom_browser_tray);
 REFERENCE_MODULE(atom_browser_window);
+REFERENCE_MODULE(atom_common_archive);
 REFERENCE_MODULE(atom_common_clipboard);
+REFERENCE_MODULE(atom_common_code_cache);
 REFERENCE_MODULE(atom_common_crash_reporter);
 REFERENCE_MODULE(atom_common_id_weak_map);
+REFERENCE_MODULE(atom_common_objects_store);
 REFERENCE_MODULE(atom_common_screen);
 REFERENCE_MODULE(atom_common_shell);
+REFERENCE_MODULE(atom_common_uv_loop);
 REFERENCE_MODULE(atom_common_v8_util);
 REFERENCE_MODULE(atom_renderer_ipc);
 REFERENCE_MODULE(atom_renderer_web_view);
@@ -83,6 +89,19 @@ namespace atom {
 
 namespace {
 
+// The NodeBindings of current process.
+NodeBindings* g_node_bindings = NULL;
+
+// Default time budget of running uv loop iterations in one wakeup.
+const int kDefaultDrainBudgetMs = 4;
+
+// Names of the uv loop histograms, in the order of UvLoopHistogram.
+const char* const kUvLoopHistogramNames[] = {
+  "AtomShell.UvLoop.WakeupLatency",
+  "AtomShell.UvLoop.RunDuration",
+  "AtomShell.UvLoop.IterationsPerRun",
+};
+
 // Empty callback for async handle.
 void UvNoOp(uv_async_t* handle) {
 }
@@ -117,12 +136,32 @@ NodeBindings::NodeBindings(bool is_browser)
     : is_browser_(is_browser),
       message_loop_(NULL),
       uv_loop_(uv_default_loop()),
+      use_embed_thread_(true),
       embed_closed_(false),
       uv_env_(NULL),
+      drain_budget_(
+          base::TimeDelta::FromMilliseconds(kDefaultDrainBudgetMs)),
       weak_factory_(this) {
+  DCHECK(!g_node_bindings);
+  g_node_bindings = this;
+
+  COMPILE_ASSERT(arraysize(kUvLoopHistogramNames) == UV_LOOP_HISTOGRAM_COUNT,
+                 histogram_names_mismatch);
+  for (int i = 0; i < UV_LOOP_HISTOGRAM_COUNT; ++i) {
+    // Durations are recorded from 1us to 10s, iterations from 1 to 10000.
+    int max = i == ITERATIONS_PER_RUN ? 10000 : 10000000;
+    uv_loop_histograms_[i] = base::Histogram::FactoryGet(
+        kUvLoopHistogramNames[i], 1, max, 50,
+        base::HistogramBase::kNoFlags);
+  }
 }
 
 NodeBindings::~NodeBindings() {
+  g_node_bindings = NULL;
+
+  if (!use_embed_thread_)
+    return;
+
   // Quit the embed thread.
   embed_closed_ = true;
   uv_sem_post(&embed_sem_);
@@ -135,6 +174,11 @@ NodeBindings::~NodeBindings() {
   uv_sem_destroy(&embed_sem_);
 }
 
+// static
+NodeBindings* NodeBindings::Get() {
+  return g_node_bindings;
+}
+
 void NodeBindings::Initialize() {
   // Open node's error reporting system for browser process.
   node::g_standalone_mode = is_browser_;
@@ -222,6 +266,9 @@ void NodeBindings::PrepareMessageLoop() {
   // nothing to do.
   uv_async_init(uv_loop_, &dummy_uv_handle_, UvNoOp);
 
+  if (!use_embed_thread_)
+    return;
+
   // Start worker that will interrupt main loop when having uv events.
   uv_sem_init(&embed_sem_, 0);
   uv_thread_create(&embed_thread_, EmbedThreadRunner, this);
@@ -252,15 +299,56 @@ void NodeBindings::UvRunOnce() {
   // Enter node context while dealing with uv events.
   v8::Context::Scope context_scope(env->context());
 
-  // Deal with uv events.
-  int r = uv_run(uv_loop_, (uv_run_mode)(UV_RUN_ONCE | UV_RUN_NOWAIT));
+  base::TimeTicks start = base::TimeTicks::Now();
+  if (!poll_returned_time_.is_null()) {
+    TRACE_EVENT_ASYNC_END0("node", "UvWakeup", this);
+    uv_loop_histograms_[WAKEUP_LATENCY]->Add(
+        (start - poll_returned_time_).InMicroseconds());
+    poll_returned_time_ = base::TimeTicks();
+  }
+
+  // Deal with uv events, under load keep running the loop while there are
+  // pending events, so we don't need a new wakeup for every iteration.
+  TRACE_EVENT_BEGIN0("node", "UvRunOnce");
+  base::TimeTicks deadline = start + drain_budget_;
+  int r;
+  int iterations = 0;
+  while (true) {
+    r = uv_run(uv_loop_, (uv_run_mode)(UV_RUN_ONCE | UV_RUN_NOWAIT));
+    ++iterations;
+    if (r == 0 || uv_loop_->stop_flag != 0)
+      break;
+    // Without a budget only one iteration is run, like a plain uv_run.
+    if (drain_budget_ == base::TimeDelta() || !HasPendingEvents())
+      break;
+    if (base::TimeTicks::Now() >= deadline) {
+      ++uv_loop_stats_.budget_exhausted;
+      break;
+    }
+  }
+  TRACE_EVENT_END1("node", "UvRunOnce", "iterations", iterations);
+
+  ++uv_loop_stats_.runs;
+  uv_loop_stats_.iterations += iterations;
+  uv_loop_histograms_[ITERATIONS_PER_RUN]->Add(iterations);
+  uv_loop_histograms_[RUN_DURATION]->Add(
+      (base::TimeTicks::Now() - start).InMicroseconds());
+
   if (r == 0 || uv_loop_->stop_flag != 0)
     message_loop_->QuitWhenIdle();  // Quit from uv.
 
+  ContinuePolling();
+}
+
+void NodeBindings::ContinuePolling() {
   // Tell the worker thread to continue polling.
   uv_sem_post(&embed_sem_);
 }
 
+bool NodeBindings::HasPendingEvents() {
+  return uv_backend_timeout(uv_loop_) == 0;
+}
+
 void NodeBindings::WakeupMainThread() {
   DCHECK(message_loop_);
   message_loop_->PostTask(FROM_HERE, base::Bind(&NodeBindings::UvRunOnce,
@@ -290,6 +378,9 @@ void NodeBindings::EmbedThreadRunner(void *arg) {
     if (self->embed_closed_)
       break;
 
+    self->poll_returned_time_ = base::TimeTicks::Now();
+    TRACE_EVENT_ASYNC_BEGIN0("node", "UvWakeup", self);
+
     // Deal with event in main thread.
     self->WakeupMainThread();
   }
@@ -7,10 +7,12 @@
 
 #include "base/basictypes.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "v8/include/v8.h"
 #include "vendor/node/deps/uv/include/uv.h"
 
 namespace base {
+class HistogramBase;
 class MessageLoop;
 }
 
@@ -22,8 +24,36 @@ namespace atom {
 
 class NodeBindings {
  public:
+  // Counters of how the uv loop is run.
+  struct UvLoopStats {
+    UvLoopStats() : runs(0), iterations(0), budget_exhausted(0) {}
+
+    // Number of times the uv loop has been woken up.
+    uint64 runs;
+    // Number of uv loop iterations, a wakeup can run many of them.
+    uint64 iterations;
+    // Number of wakeups that stopped running because of the time budget
+    // while there were still pending events.
+    uint64 budget_exhausted;
+  };
+
+  // Histograms of how the uv loop is run, durations are in microseconds.
+  enum UvLoopHistogram {
+    // From PollEvents returning in the embed thread to UvRunOnce running,
+    // which is mostly the time the task waits in the main loop.
+    WAKEUP_LATENCY = 0,
+    // How long each UvRunOnce takes.
+    RUN_DURATION,
+    // Number of uv loop iterations in each UvRunOnce.
+    ITERATIONS_PER_RUN,
+    UV_LOOP_HISTOGRAM_COUNT,
+  };
+
   static NodeBindings* Create(bool is_browser);
 
+  // Returns the NodeBindings of current process.
+  static NodeBindings* Get();
+
   virtual ~NodeBindings();
 
   // Setup V8, libuv.
@@ -42,6 +72,17 @@ class NodeBindings {
   void set_uv_env(node::Environment* env) { uv_env_ = env; }
   node::Environment* uv_env() const { return uv_env_; }
 
+  // Gets/sets how long a wakeup can keep running uv loop iterations while
+  // there are pending events, zero means only running one iteration.
+  void set_drain_budget(base::TimeDelta budget) { drain_budget_ = budget; }
+  base::TimeDelta drain_budget() const { return drain_budget_; }
+
+  const UvLoopStats& uv_loop_stats() const { return uv_loop_stats_; }
+
+  base::HistogramBase* uv_loop_histogram(UvLoopHistogram type) const {
+    return uv_loop_histograms_[type];
+  }
+
  protected:
   explicit NodeBindings(bool is_browser);
 
@@ -51,6 +92,14 @@ class NodeBindings {
   // Run the libuv loop for once.
   void UvRunOnce();
 
+  // Called after UvRunOnce to wait for new uv events, by default it tells the
+  // embed thread to continue polling.
+  virtual void ContinuePolling();
+
+  // Whether the uv loop has events to deal with right now, by default only
+  // the events that don't need polling (e.g. idle handles) are checked.
+  virtual bool HasPendingEvents();
+
   // Make the main thread run libuv loop.
   void WakeupMainThread();
 
@@ -66,6 +115,10 @@ class NodeBindings {
   // Main thread's libuv loop.
   uv_loop_t* uv_loop_;
 
+  // Whether to poll uv events in the embed thread, derived classes that can
+  // watch uv's backend fd in the main loop directly can turn it off.
+  bool use_embed_thread_;
+
  private:
   // Thread to poll uv events.
   static void EmbedThreadRunner(void *arg);
@@ -85,6 +138,17 @@ class NodeBindings {
   // Environment that to wrap the uv loop.
   node::Environment* uv_env_;
 
+  // Time budget of running uv loop iterations in one wakeup.
+  base::TimeDelta drain_budget_;
+
+  UvLoopStats uv_loop_stats_;
+
+  base::HistogramBase* uv_loop_histograms_[UV_LOOP_HISTOGRAM_COUNT];
+
+  // When PollEvents returned, it is written by the embed thread before
+  // posting the task, and reset by UvRunOnce.
+  base::TimeTicks poll_returned_time_;
+
   base::WeakPtrFactory<NodeBindings> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(NodeBindings);
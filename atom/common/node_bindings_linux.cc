@@ -6,19 +6,30 @@
 
 #include <sys/epoll.h>
 
+#include "atom/common/options_switches.h"
+#include "base/command_line.h"
+
 namespace atom {
 
 NodeBindingsLinux::NodeBindingsLinux(bool is_browser)
     : NodeBindings(is_browser),
-      epoll_(epoll_create(1)) {
+      epoll_(epoll_create(1)),
+      backend_fd_source_(0) {
   int backend_fd = uv_backend_fd(uv_loop_);
   struct epoll_event ev = { 0 };
   ev.events = EPOLLIN;
   ev.data.fd = backend_fd;
   epoll_ctl(epoll_, EPOLL_CTL_ADD, backend_fd, &ev);
+
+  // Only the browser's main loop is driven by glib, the renderer's main loop
+  // can not watch file descriptors.
+  use_embed_thread_ = !is_browser || !CommandLine::ForCurrentProcess()->
+      HasSwitch(switches::kUvEventDriven);
 }
 
 NodeBindingsLinux::~NodeBindingsLinux() {
+  if (backend_fd_source_)
+    g_source_remove(backend_fd_source_);
 }
 
 void NodeBindingsLinux::RunMessageLoop() {
@@ -26,18 +37,66 @@ void NodeBindingsLinux::RunMessageLoop() {
   uv_loop_->data = this;
   uv_loop_->on_watcher_queue_updated = OnWatcherQueueChanged;
 
+  // Run uv loop in main thread when its backend fd becomes readable, the fd
+  // is an epoll fd which is readable when any uv event is pending.
+  if (!use_embed_thread_) {
+    GIOChannel* channel = g_io_channel_unix_new(uv_backend_fd(uv_loop_));
+    backend_fd_source_ = g_io_add_watch(channel, G_IO_IN, OnBackendFdReadable,
+                                        this);
+    g_io_channel_unref(channel);
+  }
+
   NodeBindings::RunMessageLoop();
 }
 
+void NodeBindingsLinux::ContinuePolling() {
+  if (use_embed_thread_) {
+    NodeBindings::ContinuePolling();
+    return;
+  }
+
+  // The backend fd only tells us about io events, so we have to wake up the
+  // uv loop for timers and pending callbacks ourselves.
+  int timeout = uv_backend_timeout(uv_loop_);
+  if (timeout == -1)
+    uv_timer_.Stop();
+  else
+    uv_timer_.Start(FROM_HERE, base::TimeDelta::FromMilliseconds(timeout),
+                    this, &NodeBindingsLinux::UvRunOnce);
+}
+
+bool NodeBindingsLinux::HasPendingEvents() {
+  if (NodeBindings::HasPendingEvents())
+    return true;
+
+  // Check whether uv's backend fd has io events without blocking.
+  int r;
+  do {
+    struct epoll_event ev;
+    r = epoll_wait(epoll_, &ev, 1, 0);
+  } while (r == -1 && errno == EINTR);
+  return r > 0;
+}
+
 // static
 void NodeBindingsLinux::OnWatcherQueueChanged(uv_loop_t* loop) {
   NodeBindingsLinux* self = static_cast<NodeBindingsLinux*>(loop->data);
 
   // We need to break the io polling in the epoll thread when loop's watcher
-  // queue changes, otherwise new events cannot be notified.
+  // queue changes, otherwise new events cannot be notified. Without the embed
+  // thread this makes the backend fd readable, so the uv loop would run again
+  // to add the new watchers.
   self->WakeupEmbedThread();
 }
 
+// static
+gboolean NodeBindingsLinux::OnBackendFdReadable(GIOChannel* channel,
+                                                GIOCondition condition,
+                                                gpointer user_data) {
+  static_cast<NodeBindingsLinux*>(user_data)->UvRunOnce();
+  return TRUE;
+}
+
 void NodeBindingsLinux::PollEvents() {
   int timeout = uv_backend_timeout(uv_loop_);
 
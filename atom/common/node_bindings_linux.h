@@ -5,7 +5,10 @@
 #ifndef ATOM_COMMON_NODE_BINDINGS_LINUX_H_
 #define ATOM_COMMON_NODE_BINDINGS_LINUX_H_
 
+#include <glib.h>
+
 #include "base/compiler_specific.h"
+#include "base/timer/timer.h"
 #include "atom/common/node_bindings.h"
 
 namespace atom {
@@ -17,15 +20,31 @@ class NodeBindingsLinux : public NodeBindings {
 
   virtual void RunMessageLoop() OVERRIDE;
 
+ protected:
+  virtual void ContinuePolling() OVERRIDE;
+  virtual bool HasPendingEvents() OVERRIDE;
+
  private:
   // Called when uv's watcher queue changes.
   static void OnWatcherQueueChanged(uv_loop_t* loop);
 
+  // Called by glib when uv's backend fd becomes readable.
+  static gboolean OnBackendFdReadable(GIOChannel* channel,
+                                      GIOCondition condition,
+                                      gpointer user_data);
+
   virtual void PollEvents() OVERRIDE;
 
   // Epoll to poll for uv's backend fd.
   int epoll_;
 
+  // The glib source watching uv's backend fd, when the embed thread is not
+  // used.
+  guint backend_fd_source_;
+
+  // Wakes up the uv loop for its timers when the embed thread is not used.
+  base::OneShotTimer<NodeBindingsLinux> uv_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(NodeBindingsLinux);
 };
 
@@ -34,6 +34,20 @@ void NodeBindingsMac::RunMessageLoop() {
   NodeBindings::RunMessageLoop();
 }
 
+bool NodeBindingsMac::HasPendingEvents() {
+  if (NodeBindings::HasPendingEvents())
+    return true;
+
+  // Check whether uv's backend fd has io events without blocking.
+  struct timespec spec = { 0, 0 };
+  int r;
+  do {
+    struct kevent ev;
+    r = ::kevent(kqueue_, NULL, 0, &ev, 1, &spec);
+  } while (r == -1 && errno == EINTR);
+  return r > 0;
+}
+
 // static
 void NodeBindingsMac::OnWatcherQueueChanged(uv_loop_t* loop) {
   NodeBindingsMac* self = static_cast<NodeBindingsMac*>(loop->data);
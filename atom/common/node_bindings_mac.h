@@ -17,6 +17,9 @@ class NodeBindingsMac : public NodeBindings {
 
   virtual void RunMessageLoop() OVERRIDE;
 
+ protected:
+  virtual bool HasPendingEvents() OVERRIDE;
+
  private:
   // Called when uv's watcher queue changes.
   static void OnWatcherQueueChanged(uv_loop_t* loop);
@@ -51,6 +51,13 @@ const char kZoomFactor[] = "zoom-factor";
 // The menu bar is hidden unless "Alt" is pressed.
 const char kAutoHideMenuBar[] = "auto-hide-menu-bar";
 
+// Keep the renderer process when navigating to a page of the same origin.
+const char kReuseRendererProcess[] = "reuse-renderer-process";
+
+// Watch libuv's backend fd in the browser's main loop instead of polling it in
+// a separate thread, only supported on Linux.
+const char kUvEventDriven[] = "uv-event-driven";
+
 }  // namespace switches
 
 }  // namespace atom
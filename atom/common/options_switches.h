@@ -33,6 +33,9 @@ extern const char kUseContentSize[];
 extern const char kWebPreferences[];
 extern const char kZoomFactor[];
 extern const char kAutoHideMenuBar[];
+extern const char kReuseRendererProcess[];
+
+extern const char kUvEventDriven[];
 
 }  // namespace switches
 
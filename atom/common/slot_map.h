@@ -0,0 +1,149 @@
+// Copyright (c) 2014 GitHub, Inc. All rights reserved.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_SLOT_MAP_H_
+#define ATOM_COMMON_SLOT_MAP_H_
+
+#include <vector>
+
+#include "base/basictypes.h"
+
+namespace atom {
+
+// Stores values in a dense array of slots and gives each value an integer ID,
+// adding, finding and removing values are all O(1).
+//
+// The ID is made of the index of the slot and the generation of the slot. The
+// freed slots are reused through a free list, and their generation is bumped
+// so IDs of removed values never find the new values. A slot whose generation
+// is exhausted is retired instead of wrapping around, so an ID is never handed
+// out twice. Memory usage is bounded by the peak number of values stored at
+// the same time plus the retired slots. Slots used for the first time have
+// generation 0, so the first IDs are simply 1, 2, 3...
+template<typename T>
+class SlotMap {
+ public:
+  typedef int32_t ID;
+
+  // Returned by Add when there is no room left, never a valid ID.
+  static const ID kInvalidID = 0;
+
+  SlotMap() : free_head_(kNoSlot), size_(0) {}
+
+  // Stores |value| and returns its ID, which is always positive. Returns
+  // kInvalidID if all the slots are used or retired.
+  ID Add(const T& value) {
+    int32_t index;
+    if (free_head_ != kNoSlot) {
+      index = free_head_;
+      free_head_ = slots_[index].next_free;
+    } else {
+      index = static_cast<int32_t>(slots_.size());
+      if (index > kMaxIndex)
+        return kInvalidID;
+      slots_.push_back(Slot());
+    }
+
+    Slot& slot = slots_[index];
+    slot.value = value;
+    slot.used = true;
+    slot.next_free = kNoSlot;
+    ++size_;
+    return MakeID(index, slot.generation);
+  }
+
+  // Returns the value of |id|, or NULL if |id| is not in the map.
+  T* Get(ID id) {
+    Slot* slot = Find(id);
+    return slot ? &slot->value : NULL;
+  }
+
+  bool Has(ID id) const {
+    return const_cast<SlotMap*>(this)->Find(id) != NULL;
+  }
+
+  // Removes the value of |id|, returns false if |id| is not in the map.
+  bool Remove(ID id) {
+    Slot* slot = Find(id);
+    if (!slot)
+      return false;
+
+    slot->value = T();
+    slot->used = false;
+    --size_;
+
+    // Never put a slot back once its generation runs out, otherwise the next
+    // value in it would get an ID that was already given out.
+    if (slot->generation == kMaxGeneration)
+      return true;
+
+    ++slot->generation;
+    slot->next_free = free_head_;
+    free_head_ = GetIndex(id);
+    return true;
+  }
+
+  // Returns the IDs of all values.
+  std::vector<ID> Keys() const {
+    std::vector<ID> keys;
+    keys.reserve(size_);
+    for (size_t i = 0; i < slots_.size(); ++i)
+      if (slots_[i].used)
+        keys.push_back(MakeID(static_cast<int32_t>(i), slots_[i].generation));
+    return keys;
+  }
+
+  // Number of values in the map.
+  size_t size() const { return size_; }
+
+  // Number of slots allocated, including the free and retired ones.
+  size_t capacity() const { return slots_.size(); }
+
+ private:
+  // The lower bits of ID are the index plus 1, the higher bits are the
+  // generation, the sign bit is always 0.
+  static const int kIndexBits = 22;
+  static const int32_t kIndexMask = (1 << kIndexBits) - 1;
+  static const int32_t kMaxIndex = kIndexMask - 1;
+  static const int32_t kMaxGeneration = (1 << (31 - kIndexBits)) - 1;
+  static const int32_t kNoSlot = -1;
+
+  struct Slot {
+    Slot() : generation(0), next_free(kNoSlot), used(false) {}
+
+    T value;
+    int32_t generation;
+    int32_t next_free;
+    bool used;
+  };
+
+  static ID MakeID(int32_t index, int32_t generation) {
+    return (generation << kIndexBits) | (index + 1);
+  }
+
+  static int32_t GetIndex(ID id) { return (id & kIndexMask) - 1; }
+  static int32_t GetGeneration(ID id) { return id >> kIndexBits; }
+
+  Slot* Find(ID id) {
+    if (id <= 0)
+      return NULL;
+    int32_t index = GetIndex(id);
+    if (index < 0 || static_cast<size_t>(index) >= slots_.size())
+      return NULL;
+    Slot* slot = &slots_[index];
+    if (!slot->used || slot->generation != GetGeneration(id))
+      return NULL;
+    return slot;
+  }
+
+  std::vector<Slot> slots_;
+  int32_t free_head_;
+  size_t size_;
+
+  DISALLOW_COPY_AND_ASSIGN(SlotMap);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_SLOT_MAP_H_
@@ -2,9 +2,16 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <string>
+
 #include "atom/common/api/api_messages.h"
 #include "atom/common/native_mate_converters/string16_converter.h"
+#include "atom/common/native_mate_converters/v8_value_converter.h"
+#include "atom/common/native_mate_converters/v8_value_serializer.h"
 #include "atom/common/native_mate_converters/value_converter.h"
+#include "base/json/json_reader.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/strings/utf_string_conversions.h"
 #include "content/public/renderer/render_view.h"
 #include "native_mate/dictionary.h"
 #include "third_party/WebKit/public/web/WebLocalFrame.h"
@@ -30,36 +37,130 @@ RenderView* GetCurrentRenderView() {
   return RenderView::FromWebView(view);
 }
 
-void Send(const base::string16& channel, const base::ListValue& arguments) {
+void Send(v8::Isolate* isolate,
+          const base::string16& channel,
+          v8::Handle<v8::Value> arguments) {
   RenderView* render_view = GetCurrentRenderView();
   if (render_view == NULL)
     return;
 
-  bool success = render_view->Send(new AtomViewHostMsg_Message(
-      render_view->GetRoutingID(), channel, arguments));
+  // Serialize the arguments directly, and only fall back to base::ListValue
+  // when there is something the serializer can not handle.
+  IPC::Message* message;
+  std::string serialized;
+  base::ListValue list;
+  atom::V8ValueSerializer serializer;
+  if (serializer.Serialize(arguments, &serialized)) {
+    message = new AtomViewHostMsg_Message_Serialized(
+        render_view->GetRoutingID(), channel, serialized);
+  } else if (mate::ConvertFromV8(isolate, arguments, &list)) {
+    message = new AtomViewHostMsg_Message(
+        render_view->GetRoutingID(), channel, list);
+  } else {
+    node::ThrowError("Unable to serialize arguments");
+    return;
+  }
+
+  bool success = render_view->Send(message);
 
   if (!success)
     node::ThrowError("Unable to send AtomViewHostMsg_Message");
 }
 
-base::string16 SendSync(const base::string16& channel,
-                        const base::ListValue& arguments) {
-  base::string16 json;
+// Sends the messages queued by ipc.sendBatched in one IPC message.
+void SendBatch(v8::Isolate* isolate, v8::Handle<v8::Value> value) {
+  RenderView* render_view = GetCurrentRenderView();
+  if (render_view == NULL)
+    return;
 
+  if (!value->IsArray()) {
+    node::ThrowTypeError("Messages should be an array");
+    return;
+  }
+  v8::Handle<v8::Array> messages = value.As<v8::Array>();
+
+  const base::string16 channel = base::ASCIIToUTF16("ipc-message-batch");
+  IPC::Message* message;
+  std::string serialized;
+  atom::V8ValueSerializer serializer;
+  if (serializer.SerializeBatch(messages, &serialized)) {
+    message = new AtomViewHostMsg_Message_Serialized(
+        render_view->GetRoutingID(), channel, serialized);
+  } else {
+    // Convert the messages one by one for the same reason.
+    base::ListValue* list = new base::ListValue;
+    for (uint32 i = 0; i < messages->Length(); ++i) {
+      base::ListValue* item = new base::ListValue;
+      list->Append(item);
+      if (!mate::ConvertFromV8(isolate, messages->Get(i), item)) {
+        delete list;
+        node::ThrowError("Unable to serialize arguments");
+        return;
+      }
+    }
+    base::ListValue args;
+    args.Append(list);
+    message = new AtomViewHostMsg_Message(
+        render_view->GetRoutingID(), channel, args);
+  }
+
+  if (!render_view->Send(message))
+    node::ThrowError("Unable to send AtomViewHostMsg_Message");
+}
+
+v8::Handle<v8::Value> SendSync(v8::Isolate* isolate,
+                               const base::string16& channel,
+                               v8::Handle<v8::Value> arguments) {
   RenderView* render_view = GetCurrentRenderView();
   if (render_view == NULL)
-    return json;
+    return v8::Undefined(isolate);
+
+  // Prefer the serialized message, whose reply can be deserialized directly
+  // without going through JSON.
+  atom::V8ValueSerializer serializer;
+  std::string serialized_args;
+  if (serializer.Serialize(arguments, &serialized_args)) {
+    std::string serialized_result;
+    IPC::SyncMessage* message = new AtomViewHostMsg_Message_Sync_Serialized(
+        render_view->GetRoutingID(), channel, serialized_args,
+        &serialized_result);
+    // Enable the UI thread in browser to receive messages.
+    message->EnableMessagePumping();
+    if (!render_view->Send(message)) {
+      node::ThrowError(
+          "Unable to send AtomViewHostMsg_Message_Sync_Serialized");
+      return v8::Undefined(isolate);
+    }
+
+    v8::Handle<v8::Value> result =
+        serializer.Deserialize(isolate, serialized_result);
+    if (result.IsEmpty())
+      return v8::Undefined(isolate);
+    return result;
+  }
+
+  base::ListValue list;
+  if (!mate::ConvertFromV8(isolate, arguments, &list)) {
+    node::ThrowError("Unable to serialize arguments");
+    return v8::Undefined(isolate);
+  }
 
+  base::string16 json;
   IPC::SyncMessage* message = new AtomViewHostMsg_Message_Sync(
-      render_view->GetRoutingID(), channel, arguments, &json);
-  // Enable the UI thread in browser to receive messages.
+      render_view->GetRoutingID(), channel, list, &json);
   message->EnableMessagePumping();
-  bool success = render_view->Send(message);
-
-  if (!success)
+  if (!render_view->Send(message)) {
     node::ThrowError("Unable to send AtomViewHostMsg_Message_Sync");
+    return v8::Undefined(isolate);
+  }
+
+  scoped_ptr<base::Value> result(
+      base::JSONReader::Read(base::UTF16ToUTF8(json)));
+  if (!result)
+    return v8::Undefined(isolate);
 
-  return json;
+  atom::V8ValueConverter converter;
+  return converter.ToV8Value(result.get(), isolate->GetCurrentContext());
 }
 
 void Initialize(v8::Handle<v8::Object> exports, v8::Handle<v8::Value> unused,
@@ -67,6 +168,7 @@ void Initialize(v8::Handle<v8::Object> exports, v8::Handle<v8::Value> unused,
   mate::Dictionary dict(context->GetIsolate(), exports);
   dict.SetMethod("send", &Send);
   dict.SetMethod("sendSync", &SendSync);
+  dict.SetMethod("sendBatch", &SendBatch);
 }
 
 }  // namespace
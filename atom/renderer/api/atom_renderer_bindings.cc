@@ -8,6 +8,8 @@
 
 #include "atom/common/native_mate_converters/string16_converter.h"
 #include "atom/common/native_mate_converters/v8_value_converter.h"
+#include "atom/common/native_mate_converters/v8_value_serializer.h"
+#include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/values.h"
 #include "content/public/renderer/render_view.h"
@@ -65,12 +67,10 @@ void AtomRendererBindings::OnBrowserMessage(content::RenderView* render_view,
 
   v8::Context::Scope context_scope(context);
 
-  v8::Handle<v8::Object> process = GetProcessObject(context);
   scoped_ptr<V8ValueConverter> converter(new V8ValueConverter);
 
   std::vector<v8::Handle<v8::Value>> arguments;
-  arguments.reserve(1 + args.GetSize());
-  arguments.push_back(mate::ConvertToV8(isolate, channel));
+  arguments.reserve(args.GetSize());
 
   for (size_t i = 0; i < args.GetSize(); i++) {
     const base::Value* value;
@@ -78,6 +78,48 @@ void AtomRendererBindings::OnBrowserMessage(content::RenderView* render_view,
       arguments.push_back(converter->ToV8Value(value, context));
   }
 
+  EmitOnProcess(context, channel, arguments);
+}
+
+void AtomRendererBindings::OnBrowserMessageSerialized(
+    content::RenderView* render_view,
+    const base::string16& channel,
+    const std::string& serialized_args) {
+  if (!render_view->GetWebView())
+    return;
+
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::HandleScope handle_scope(isolate);
+
+  v8::Local<v8::Context> context =
+      render_view->GetWebView()->mainFrame()->mainWorldScriptContext();
+  if (context.IsEmpty())
+    return;
+
+  v8::Context::Scope context_scope(context);
+
+  std::vector<v8::Handle<v8::Value>> arguments;
+  V8ValueSerializer serializer;
+  if (!serializer.DeserializeArray(isolate, serialized_args, &arguments)) {
+    LOG(ERROR) << "Invalid serialized arguments for channel " << channel;
+    return;
+  }
+
+  EmitOnProcess(context, channel, arguments);
+}
+
+void AtomRendererBindings::EmitOnProcess(
+    v8::Handle<v8::Context> context,
+    const base::string16& channel,
+    const std::vector<v8::Handle<v8::Value>>& args) {
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::Handle<v8::Object> process = GetProcessObject(context);
+
+  std::vector<v8::Handle<v8::Value>> arguments;
+  arguments.reserve(1 + args.size());
+  arguments.push_back(mate::ConvertToV8(isolate, channel));
+  arguments.insert(arguments.end(), args.begin(), args.end());
+
   node::MakeCallback(isolate, process, "emit", arguments.size(), &arguments[0]);
 }
 
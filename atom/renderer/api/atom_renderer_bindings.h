@@ -5,6 +5,9 @@
 #ifndef ATOM_RENDERER_API_ATOM_RENDERER_BINDINGS_H_
 #define ATOM_RENDERER_API_ATOM_RENDERER_BINDINGS_H_
 
+#include <string>
+#include <vector>
+
 #include "atom/common/api/atom_bindings.h"
 
 #include "base/strings/string16.h"
@@ -36,7 +39,17 @@ class AtomRendererBindings : public AtomBindings {
                         const base::string16& channel,
                         const base::ListValue& args);
 
+  // Dispatch messages with serialized arguments from browser.
+  void OnBrowserMessageSerialized(content::RenderView* render_view,
+                                  const base::string16& channel,
+                                  const std::string& serialized_args);
+
  private:
+  // process.emit(channel, args...) under |context|.
+  void EmitOnProcess(v8::Handle<v8::Context> context,
+                     const base::string16& channel,
+                     const std::vector<v8::Handle<v8::Value>>& args);
+
   DISALLOW_COPY_AND_ASSIGN(AtomRendererBindings);
 };
 
@@ -68,6 +68,8 @@ bool AtomRenderViewObserver::OnMessageReceived(const IPC::Message& message) {
   bool handled = true;
   IPC_BEGIN_MESSAGE_MAP(AtomRenderViewObserver, message)
     IPC_MESSAGE_HANDLER(AtomViewMsg_Message, OnBrowserMessage)
+    IPC_MESSAGE_HANDLER(AtomViewMsg_Message_Serialized,
+                        OnBrowserMessageSerialized)
     IPC_MESSAGE_UNHANDLED(handled = false)
   IPC_END_MESSAGE_MAP()
 
@@ -87,4 +89,18 @@ void AtomRenderViewObserver::OnBrowserMessage(const base::string16& channel,
       render_view(), channel, args);
 }
 
+void AtomRenderViewObserver::OnBrowserMessageSerialized(
+    const base::string16& channel,
+    const std::string& serialized_args) {
+  if (!render_view()->GetWebView())
+    return;
+
+  blink::WebFrame* frame = render_view()->GetWebView()->mainFrame();
+  if (!renderer_client_->IsNodeBindingEnabled(frame))
+    return;
+
+  renderer_client_->atom_bindings()->OnBrowserMessageSerialized(
+      render_view(), channel, serialized_args);
+}
+
 }  // namespace atom
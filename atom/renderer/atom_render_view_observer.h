@@ -5,6 +5,8 @@
 #ifndef ATOM_RENDERER_ATOM_RENDER_VIEW_OBSERVER_H_
 #define ATOM_RENDERER_ATOM_RENDER_VIEW_OBSERVER_H_
 
+#include <string>
+
 #include "content/public/renderer/render_view_observer.h"
 
 namespace base {
@@ -31,6 +33,8 @@ class AtomRenderViewObserver : public content::RenderViewObserver {
 
   void OnBrowserMessage(const base::string16& channel,
                         const base::ListValue& args);
+  void OnBrowserMessageSerialized(const base::string16& channel,
+                                  const std::string& serialized_args);
 
   // Weak reference to renderer client.
   AtomRendererClient* renderer_client_;
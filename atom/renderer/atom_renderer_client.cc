@@ -52,6 +52,106 @@ class AtomRenderFrameObserver : public content::RenderFrameObserver {
   DISALLOW_COPY_AND_ASSIGN(AtomRenderFrameObserver);
 };
 
+// How long to wait for the handles and requests of an unloaded page before
+// giving up on disposing its environment.
+const uint64_t kDisposeTimeoutMs = 60 * 1000;
+
+// Whether the native module |name| has been loaded by process.binding in |env|.
+bool IsBindingLoaded(node::Environment* env, const char* name) {
+  v8::HandleScope handle_scope(env->isolate());
+  return env->binding_cache_object()->Has(
+      v8::String::NewFromUtf8(env->isolate(), name));
+}
+
+// Disposes a node environment after all of its uv handles and requests have
+// finished, because their callbacks would still need the environment. If
+// they never finish the environment is leaked, since disposing it under a
+// live callback would crash.
+class EnvironmentDisposer {
+ public:
+  static void Start(node::Environment* env) {
+    new EnvironmentDisposer(env);
+  }
+
+ private:
+  explicit EnvironmentDisposer(node::Environment* env)
+      : env_(env),
+        pending_closes_(0),
+        deadline_(uv_now(env->event_loop()) + kDisposeTimeoutMs),
+        dispose_(true),
+        has_cares_(IsBindingLoaded(env, "cares_wrap")) {
+    // Close the handles that are owned by the environment itself.
+    CloseHandle(reinterpret_cast<uv_handle_t*>(env->immediate_check_handle()));
+    CloseHandle(reinterpret_cast<uv_handle_t*>(env->immediate_idle_handle()));
+    CloseHandle(reinterpret_cast<uv_handle_t*>(env->idle_prepare_handle()));
+    CloseHandle(reinterpret_cast<uv_handle_t*>(env->idle_check_handle()));
+
+    // The timer of c-ares is only initialized with the cares_wrap module.
+    if (has_cares_)
+      CloseHandle(reinterpret_cast<uv_handle_t*>(env->cares_timer_handle()));
+
+    // Check whether everything is done after every loop iteration.
+    uv_check_init(env->event_loop(), &check_handle_);
+    check_handle_.data = this;
+    uv_check_start(&check_handle_, OnCheck);
+    uv_unref(reinterpret_cast<uv_handle_t*>(&check_handle_));
+  }
+
+  ~EnvironmentDisposer() {
+    if (!dispose_)
+      return;
+    v8::HandleScope handle_scope(env_->isolate());
+    // Cancels the DNS queries that are still running and closes their sockets.
+    if (has_cares_)
+      ares_destroy(env_->cares_channel());
+    env_->Dispose();
+  }
+
+  void CloseHandle(uv_handle_t* handle) {
+    ++pending_closes_;
+    handle->data = this;
+    uv_close(handle, OnHandleClosed);
+  }
+
+  bool IsDone() const {
+    return pending_closes_ == 0 &&
+           QUEUE_EMPTY(env_->handle_wrap_queue()) &&
+           QUEUE_EMPTY(env_->req_wrap_queue());
+  }
+
+  static void OnHandleClosed(uv_handle_t* handle) {
+    --static_cast<EnvironmentDisposer*>(handle->data)->pending_closes_;
+  }
+
+  static void OnCheck(uv_check_t* handle) {
+    EnvironmentDisposer* self = static_cast<EnvironmentDisposer*>(handle->data);
+    if (!self->IsDone()) {
+      // The closing handles still point to us, so always wait for them.
+      if (self->pending_closes_ > 0 || uv_now(handle->loop) < self->deadline_)
+        return;
+      LOG(WARNING) << "Leaking the node environment of an unloaded page, "
+                   << "its handles or requests never finished";
+      self->dispose_ = false;
+    }
+
+    uv_check_stop(handle);
+    uv_close(reinterpret_cast<uv_handle_t*>(handle), OnCheckClosed);
+  }
+
+  static void OnCheckClosed(uv_handle_t* handle) {
+    delete static_cast<EnvironmentDisposer*>(handle->data);
+  }
+
+  node::Environment* env_;
+  int pending_closes_;
+  uint64_t deadline_;
+  bool dispose_;
+  bool has_cares_;
+  uv_check_t check_handle_;
+
+  DISALLOW_COPY_AND_ASSIGN(EnvironmentDisposer);
+};
+
 }  // namespace
 
 AtomRendererClient::AtomRendererClient()
@@ -161,14 +261,11 @@ void AtomRendererClient::WillReleaseScriptContext(
       std::remove(web_page_envs_.begin(), web_page_envs_.end(), env),
       web_page_envs_.end());
 
-  // Notice that we are not disposing the environment object here, because there
-  // may still be pending uv operations in the uv loop, and when they got done
-  // they would be needing the original environment.
-  // So we are leaking the environment object here, just like Chrome leaking the
-  // memory :) . Since it's only leaked when refreshing or unloading, so as long
-  // as we make sure renderer process is restared then the memory would not be
-  // leaked.
-  // env->Dispose();
+  // There may still be pending uv operations in the uv loop, and when they got
+  // done they would be needing the original environment, so we only dispose
+  // the environment after they are all done. The handles created by the page
+  // are closed in the unload handler in init.coffee.
+  EnvironmentDisposer::Start(env);
 
   // Wrap the uv loop with another environment.
   if (env == node_bindings_->uv_env()) {
@@ -0,0 +1,57 @@
+#!/usr/bin/env python
+
+import argparse
+import json
+import os
+import struct
+import sys
+
+
+def main():
+  args = parse_args()
+
+  files = []
+  header = create_header(os.path.abspath(args.directory), files)
+  header_json = json.dumps(header, separators=(',', ':'), sort_keys=True)
+
+  with open(args.output, 'wb') as archive:
+    archive.write(struct.pack('<I', len(header_json)))
+    archive.write(header_json)
+    for path in files:
+      with open(path, 'rb') as source:
+        archive.write(source.read())
+
+
+def create_header(directory, files):
+  # Walks |directory| and returns the header of it, the files are appended to
+  # |files| in the order of their offsets.
+  offset = [0]
+
+  def walk(path):
+    node = {'files': {}}
+    for name in sorted(os.listdir(path)):
+      child = os.path.join(path, name)
+      if os.path.isdir(child):
+        node['files'][name] = walk(child)
+      else:
+        size = os.path.getsize(child)
+        node['files'][name] = {'offset': offset[0], 'size': size}
+        offset[0] += size
+        files.append(child)
+    return node
+
+  return walk(directory)
+
+
+def parse_args():
+  parser = argparse.ArgumentParser(
+      description='Pack a directory into an archive that atom-shell can read')
+  parser.add_argument('directory',
+                      help='The directory to pack, usually the app')
+  parser.add_argument('output',
+                      help='Path of the archive, e.g. resources/app.atar')
+  return parser.parse_args()
+
+
+if __name__ == '__main__':
+  sys.exit(main())
@@ -101,6 +101,7 @@ def main():
   args = parse_args()
 
   force_build()
+  generate_code_cache()
   download_libchromiumcontent_symbols(args.url)
   create_symbols()
   copy_binaries()
@@ -132,6 +133,17 @@ def force_build():
   execute([sys.executable, build, '-c', 'Release'])
 
 
+def generate_code_cache():
+  # Let the built atom-shell create the code caches of its own scripts, the
+  # caches only work with the V8 that created them.
+  executable = {
+    'darwin': os.path.join('Atom.app', 'Contents', 'MacOS', 'Atom'),
+    'win32': 'atom.exe',
+    'linux': 'atom',
+  }[TARGET_PLATFORM]
+  execute([os.path.join(OUT_DIR, executable), '--produce-code-cache'])
+
+
 def copy_binaries():
   for binary in TARGET_BINARIES[TARGET_PLATFORM]:
     shutil.copy2(os.path.join(OUT_DIR, binary), DIST_DIR)
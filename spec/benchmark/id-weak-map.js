@@ -0,0 +1,51 @@
+// Measures the throughput of IDWeakMap, run it with:
+//   atom spec/benchmark/id-weak-map.js
+
+var IDWeakMap = require('id-weak-map');
+var v8Util = process.atomBinding('v8_util');
+
+var COUNT = 200000;
+
+function measure(name, fn) {
+  var start = process.hrtime();
+  fn();
+  var time = process.hrtime(start);
+  var ms = time[0] * 1e3 + time[1] / 1e6;
+  console.log(name + ': ' + Math.round(COUNT / ms * 1000) + ' ops/sec');
+}
+
+var map = new IDWeakMap;
+var objects = [];
+var keys = [];
+for (var i = 0; i < COUNT; ++i)
+  objects.push({});
+
+measure('add', function() {
+  for (var i = 0; i < COUNT; ++i)
+    keys.push(map.add(objects[i]));
+});
+
+measure('get', function() {
+  for (var i = 0; i < COUNT; ++i)
+    map.get(keys[i]);
+});
+
+measure('remove', function() {
+  for (var i = 0; i < COUNT; ++i)
+    map.remove(keys[i]);
+});
+
+// Removed slots are reused by later adds.
+for (var i = 0; i < COUNT; ++i)
+  map.add(objects[i]);
+objects = null;
+
+// Taking heap snapshot forces a full GC, which runs the weak callbacks.
+measure('gc', function() {
+  v8Util.takeHeapSnapshot();
+});
+
+if (map.keys().length != 0)
+  console.error('Objects are not removed after GC');
+
+process.exit(0);
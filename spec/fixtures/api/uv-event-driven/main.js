@@ -0,0 +1,19 @@
+var fs = require('fs');
+
+// Prints "ok" when both a uv timer and an fs callback have fired.
+var pending = 2;
+function finish() {
+  if (--pending != 0)
+    return;
+  process.stdout.write('ok');
+  process.exit(0);
+}
+
+setTimeout(finish, 10);
+fs.readFile(__filename, function(error) {
+  if (error) {
+    process.stdout.write(error.message);
+    process.exit(1);
+  }
+  finish();
+});
@@ -0,0 +1,9 @@
+var protocol = require('protocol');
+
+exports.register = function(scheme, data) {
+  protocol.registerProtocol(scheme, function(request, callback) {
+    setTimeout(function() {
+      callback(data);
+    }, 10);
+  });
+}
@@ -0,0 +1,14 @@
+var protocol = require('protocol');
+
+var count = 0;
+
+exports.register = function(scheme, data) {
+  protocol.registerProtocol(scheme, function(request) {
+    count++;
+    return data;
+  });
+}
+
+exports.getCount = function() {
+  return count;
+}
@@ -32,6 +32,13 @@ ipc.on('echo', function(event, msg) {
   event.returnValue = msg;
 });
 
+// Size of the last batch sent by ipc.sendBatched, counted here because the
+// remote listeners in renderer are called after the batch has been handled.
+var lastBatchSize = 0;
+ipc.on('get-last-batch-size', function(event) {
+  event.returnValue = lastBatchSize;
+});
+
 if (process.argv[1] == '--ci') {
   process.removeAllListeners('uncaughtException');
   process.on('uncaughtException', function(error) {
@@ -144,6 +151,9 @@ app.on('ready', function() {
       javascript: true  // Test whether web-preferences crashes.
     },
   });
+  window.webContents.on('ipc-message-batch', function(event, messages) {
+    lastBatchSize = messages.length;
+  });
   window.loadUrl('file://' + __dirname + '/index.html');
   window.on('unresponsive', function() {
     var chosen = dialog.showMessageBox(window, {